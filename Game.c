@@ -22,17 +22,12 @@
 #include <stdio.h>
 #include <string.h>
 #include <assert.h>
+#include <stdint.h>
 #include "Game.h"
+#include "GameExt.h"
+#include "boardTopology.h"
 
 #define NUM_DISCIPLINE 6
-#define MAP_ARC_HEIGHT 21
-#define MAP_ARC_WIDTH 11
-#define MAP_VERTEX_HEIGHT 11
-#define MAP_VERTEX_WIDTH 6
-#define MAP_REGION_HEIGHT 9
-#define MAP_REGION_WIDTH 5
-#define VERTEX_SIZE sizeof(int) * MAP_VERTEX_HEIGHT * MAP_VERTEX_HEIGHT
-#define ARC_SIZE sizeof(int) * MAP_ARC_HEIGHT * MAP_ARC_WIDTH
 
 #define STARTING_TURN_NUM -1
 #define STARTING_KPI 20
@@ -46,43 +41,29 @@
 #define STARTING_MJ_MTV_MMONEY 1
 #define STARTING_EXCHANGE_RATE 3
 
-typedef struct _region {
-    int discipline;
-    int diceValue;
-} region;
-
-typedef struct _coord {
-    int x;
-    int y;
-    char lastMove; // optional
-} coord;
+#define MIN_DICE_VALUE 2
+#define MAX_DICE_VALUE 12
+#define NUM_DICE_VALUES (MAX_DICE_VALUE - MIN_DICE_VALUE + 1)
+
+// the parts of the game that make up the hash. each is keyed on a
+// kind, an index within that kind and the value it holds
+#define HASH_VERTEX 1
+#define HASH_ARC 2
+#define HASH_TURN 3
+#define HASH_STUDENTS 4
+#define HASH_MOST_ARCS 5
+#define HASH_MOST_PUBLICATIONS 6
+#define HASH_GO8_COUNT 7
+#define HASH_PATENTS 8
+#define HASH_PUBLICATIONS 9
+#define HASH_BOARD_DISCIPLINE 10
+#define HASH_BOARD_DICE 11
 
 typedef struct _game {
-    // basic state information
-    int turnNumber;
-    int whoseTurn;
-    int mostARCgrants;
-    int mostPublications;
-    int numGO8s;
-
-    // scores for each university
-    int kpi[NUM_UNIS];
-    int arcGrants[NUM_UNIS];
-    int campuses[NUM_UNIS];
-    int groupOfEights[NUM_UNIS];
-    int patents[NUM_UNIS];
-    int publications[NUM_UNIS];
-
-    // each discipline for each university
-    int students[NUM_UNIS][NUM_DISCIPLINE];
-    int exchangeRates[NUM_UNIS][NUM_DISCIPLINE];
-
-    // board layout settings
-    int *boardTileDisciplines;
-    int *boardTileDice;
-
-    // the board is represented as a flattened grid
-    /* for example:
+    // vertices and arcs are stored as bitmasks over their IDs, which
+    // are handed out row by row (y axis then x axis) over the board
+    // grids, for example:
+    /*
     *         0123456789A
     *         0 1 2 3 4 5
     *          0 1 2 3 4
@@ -108,34 +89,89 @@ typedef struct _game {
     * 19          | |
     * 20 10       *-*R
     */
-    // vertices, arcs and regions are separate but map to each other
-    // (y axis then x axis)
-    int vertices[MAP_VERTEX_HEIGHT][MAP_VERTEX_WIDTH];
-    int arcs[MAP_ARC_HEIGHT][MAP_ARC_WIDTH];
-    region regions[MAP_REGION_HEIGHT][MAP_REGION_WIDTH];
+    // campusMask has every campus and GO8 a university owns, go8Mask
+    // marks which of all of those are GO8s
+    uint64_t campusMask[NUM_UNIS];
+    uint64_t go8Mask;
+    arcSet arcMask[NUM_UNIS];
+
+    // where each university could build next, see getCampusFrontier()
+    uint64_t campusFrontier[NUM_UNIS];
+    arcSet arcFrontier[NUM_UNIS];
+
+    // zobrist hash of everything except the turn number, kept up to
+    // date as the game changes
+    uint64_t hash;
+
+    // basic state information
+    int32_t turnNumber;
+
+    // each discipline for each university
+    uint16_t students[NUM_UNIS][NUM_DISCIPLINE];
+
+    // scores for each university
+    int16_t kpi[NUM_UNIS];
+    uint16_t patents[NUM_UNIS];
+    uint16_t publications[NUM_UNIS];
+    uint8_t arcGrants[NUM_UNIS];
+    uint8_t campuses[NUM_UNIS];
+    uint8_t groupOfEights[NUM_UNIS];
+    uint8_t exchangeRates[NUM_UNIS][NUM_DISCIPLINE];
+
+    uint8_t whoseTurn;
+    uint8_t mostARCgrants;
+    uint8_t mostPublications;
+    uint8_t numGO8s;
+
+    // board layout settings, copied out of the arrays given to newGame,
+    // and a hash of them
+    uint8_t boardTileDisciplines[NUM_REGIONS];
+    uint8_t boardTileDice[NUM_REGIONS];
+    uint64_t boardHash;
+
+    // students gained by each university for each dice value, kept up
+    // to date as campuses are built so throwDice is a single add
+    uint8_t production[NUM_DICE_VALUES][NUM_UNIS][NUM_DISCIPLINE];
 } game;
 
-static int isValidRegion(int x, int y);
-static int isValidVertex(int x, int y);
-static int isValidARC(int x, int y);
-static int isValidAction(Game g, action a);
+static int decodePathState(const char *p);
+static int decodeTarget(int actionCode, path p);
+static int moveTarget(move m);
+static int isValidActionAt(Game g, int actionCode, int target,
+        int disciplineFrom, int disciplineTo);
 static int hasMostARCgrants(Game g, int player);
-static int ownsARCadjacentTo(Game g, coord arc, int player);
-static int ownsVertexBorderingARC(Game g, coord arc, int player);
-static int ownsARCborderingVertex(Game g, coord vertex, int player);
-static int isCampusAdjacent(Game g, coord vertex);
+static int ownsARCadjacentTo(Game g, int arcId, int player);
+static int ownsVertexBorderingARC(Game g, int arcId, int player);
+static int ownsARCborderingVertex(Game g, int vertexId, int player);
+static int isCampusAdjacent(Game g, int vertexId);
+static uint64_t occupiedVertices(Game g);
+static void findLegalTargets(Game g, uint64_t *campusSites,
+        uint64_t *go8Sites, arcSet *arcSlots);
+static int canRetrainFrom(Game g, int player, int discipline);
+static int popCount(uint64_t bits);
+static int lowestBit(uint64_t bits);
 static void updateKPI(Game g, int player, int actionCode);
-static void updateArc(Game g, int x, int y, int newValue);
-static void updateVertex(Game g, int x, int y, int newValue);
-static void updateExchangeRate(Game g, coord vertex, int player);
-static region getRegionForCoordinates(Game g, int x, int y);
-static coord getVertexCoordinateFromPath(path p);
-static coord getCoordinateFromPath(path p, int getArcCoord);
-static coord getARCCoordinateFromPath(path p);
+static uint64_t zobristKey(int kind, int index, int value);
+static uint64_t computeStateHash(Game g);
+static int relabel(int player, int mover);
+static void hashChange(Game g, int kind, int index, int oldValue,
+        int newValue);
+static void hashStudents(Game g, int player,
+        const uint16_t before[NUM_DISCIPLINE]);
+static arcSet vacantArcs(Game g);
+static void updateArc(Game g, int arcId, int newValue);
+static void updateVertex(Game g, int vertexId, int newValue);
+static void clearVertex(Game g, int vertexId, int oldValue);
+static void updateProduction(Game g, int vertexId, int player,
+        int amount);
+static void startUndoRecord(Game g, undoRecord *undo, int kind);
+static void finishUndoRecord(Game g, undoRecord *undo);
+static void undoStudentsAndKPI(Game g, const undoRecord *undo);
+static void updateExchangeRate(Game g, int vertexId, int player);
 
 #ifdef DODGY_MAIN
 int main(void) {
-    coord c = getVertexCoordinateFromPath("RRLRLLLRLLL");
+    coord c = vertexCoords[pathToVertexId("RRLRLLLRLLL")];
     assert(c.x == 2 && c.y == 3);
     return 0;
 }
@@ -144,13 +180,16 @@ int main(void) {
 // Game functions implementing Game.h
 Game newGame(int discipline[], int dice[]) {
     game *g = malloc(sizeof(game));
+    resetGame(g, discipline, dice);
+    return g;
+}
+
+void resetGame(Game g, int discipline[], int dice[]) {
     g->turnNumber = STARTING_TURN_NUM;
     g->whoseTurn = NO_ONE;
     g->mostARCgrants = NO_ONE;
     g->mostPublications = NO_ONE;
     g->numGO8s = 0;
-    g->boardTileDisciplines = discipline;
-    g->boardTileDice = dice;
 
     int player = UNI_A - 1;
     while (player < NUM_UNIS) {
@@ -179,38 +218,35 @@ Game newGame(int discipline[], int dice[]) {
         player++;
     }
 
-    int x = 0;
-    int arrayIndex = 0;
-    while (x < 5) {
-        int y = 0;
-        while (y < 9) {
-            if (isValidRegion(x,y)) {
-                region r;
-                r.discipline = discipline[arrayIndex];
-                r.diceValue = dice[arrayIndex];
-                arrayIndex++;
-                // DEBUG: printf("+1 ");
-                g->regions[y][x] = r;
-            }
-            y++;
-        }
-        x++;
+    int regionID = 0;
+    g->boardHash = 0;
+    while (regionID < NUM_REGIONS) {
+        g->boardTileDisciplines[regionID] = discipline[regionID];
+        g->boardTileDice[regionID] = dice[regionID];
+        g->boardHash ^= zobristKey(HASH_BOARD_DISCIPLINE, regionID,
+                                   discipline[regionID]) ^
+                zobristKey(HASH_BOARD_DICE, regionID, dice[regionID]);
+        regionID++;
     }
 
-    memset(g->vertices, VACANT_VERTEX, VERTEX_SIZE);
-    memset(g->arcs, VACANT_ARC, ARC_SIZE);
+    memset(g->campusMask, 0, sizeof(g->campusMask));
+    memset(g->arcMask, 0, sizeof(g->arcMask));
+    g->go8Mask = 0;
+    memset(g->campusFrontier, 0, sizeof(g->campusFrontier));
+    memset(g->arcFrontier, 0, sizeof(g->arcFrontier));
+    memset(g->production, 0, sizeof(g->production));
 
     // player 1 starting points
-    updateVertex(g, 2, 0, CAMPUS_A);
-    updateVertex(g, 3, 10, CAMPUS_A);
+    updateVertex(g, vertexIds[0][2], CAMPUS_A);
+    updateVertex(g, vertexIds[10][3], CAMPUS_A);
     // player 2 starting points 0,3 5,7 0,7 5,13
-    updateVertex(g, 0, 3, CAMPUS_B);
-    updateVertex(g, 5, 7, CAMPUS_B);
+    updateVertex(g, vertexIds[3][0], CAMPUS_B);
+    updateVertex(g, vertexIds[7][5], CAMPUS_B);
     // player 3 starting points 0,8 5,2 1,16 9,4
-    updateVertex(g, 0, 8, CAMPUS_C);
-    updateVertex(g, 5, 2, CAMPUS_C);
+    updateVertex(g, vertexIds[8][0], CAMPUS_C);
+    updateVertex(g, vertexIds[2][5], CAMPUS_C);
 
-    return g;
+    g->hash = computeStateHash(g);
 }
 
 void disposeGame(Game g) {
@@ -218,39 +254,72 @@ void disposeGame(Game g) {
     g = NULL;
 }
 
+Game cloneGame(Game g) {
+    game *clone = malloc(sizeof(game));
+    memcpy(clone, g, sizeof(game));
+    return clone;
+}
+
+void copyGameInto(Game dest, Game src) {
+    memcpy(dest, src, sizeof(game));
+}
+
 void makeAction(Game g, action a) {
-    if (!isValidAction(g, a)) {
+    makeActionAt(g, a.actionCode, decodeTarget(a.actionCode,
+            a.destination), a.disciplineFrom, a.disciplineTo);
+}
+
+void makeMove(Game g, move m) {
+    makeActionAt(g, MOVE_CODE(m), moveTarget(m), MOVE_FROM(m),
+            MOVE_TO(m));
+}
+
+void makeMoveWithUndo(Game g, move m, undoRecord *undo) {
+    makeActionWithUndo(g, MOVE_CODE(m), moveTarget(m), MOVE_FROM(m),
+            MOVE_TO(m), undo);
+}
+
+void makeActionAt(Game g, int actionCode, int target,
+        int disciplineFrom, int disciplineTo) {
+    if (!isValidActionAt(g, actionCode, target, disciplineFrom,
+            disciplineTo)) {
         printf("ERROR: INVALID ACTION\n");
     }
-    int actionType = a.actionCode;
+    int actionType = actionCode;
     int currentPlayer = getWhoseTurn(g);
+    int mostARCsBefore = g->mostARCgrants;
+    int mostPublicationsBefore = g->mostPublications;
+    uint16_t studentsBefore[NUM_DISCIPLINE];
+    if (UNI_A <= currentPlayer && currentPlayer <= UNI_C) {
+        memcpy(studentsBefore, g->students[currentPlayer-1],
+                sizeof(studentsBefore));
+    }
+
     if (actionType == BUILD_CAMPUS) {
         g->students[currentPlayer-1][STUDENT_BQN]--;
         g->students[currentPlayer-1][STUDENT_BPS]--;
         g->students[currentPlayer-1][STUDENT_MJ]--;
         g->students[currentPlayer-1][STUDENT_MTV]--;
 
-        coord pos = getVertexCoordinateFromPath(a.destination);
-        updateVertex(g, pos.x, pos.y, currentPlayer);
+        updateVertex(g, target, currentPlayer);
         g->campuses[currentPlayer-1]++;
-        updateExchangeRate(g, pos, currentPlayer);
+        updateExchangeRate(g, target, currentPlayer);
         updateKPI(g, currentPlayer, BUILD_CAMPUS);
     } else if (actionType == BUILD_GO8) {
         g->students[currentPlayer-1][STUDENT_MJ] -= 2;
         g->students[currentPlayer-1][STUDENT_MMONEY] -= 3;
 
-        coord pos = getVertexCoordinateFromPath(a.destination);
-        updateVertex(g, pos.x, pos.y, currentPlayer+3);
+        updateVertex(g, target, currentPlayer+3);
         g->groupOfEights[currentPlayer-1]++;
         g->campuses[currentPlayer-1]--;
         g->numGO8s++;
+        hashChange(g, HASH_GO8_COUNT, 0, g->numGO8s-1, g->numGO8s);
         updateKPI(g, currentPlayer, BUILD_GO8);
     } else if (actionType == OBTAIN_ARC) {
         g->students[currentPlayer-1][STUDENT_BPS]--;
         g->students[currentPlayer-1][STUDENT_BQN]--;
 
-        coord path = getARCCoordinateFromPath(a.destination);
-        updateArc(g, path.x, path.y, currentPlayer);
+        updateArc(g, target, currentPlayer);
         g->arcGrants[currentPlayer-1]++;
         updateKPI(g, currentPlayer, OBTAIN_ARC);
     } else if (actionType == OBTAIN_PUBLICATION ||
@@ -261,52 +330,46 @@ void makeAction(Game g, action a) {
 
         if (actionType == OBTAIN_PUBLICATION) {
             g->publications[currentPlayer-1]++;
+            hashChange(g, HASH_PUBLICATIONS, currentPlayer,
+                    g->publications[currentPlayer-1]-1,
+                    g->publications[currentPlayer-1]);
             updateKPI(g, currentPlayer, OBTAIN_PUBLICATION);
         } else { // actionType == OBTAIN_IP_PATENT
             g->patents[currentPlayer-1]++;
+            hashChange(g, HASH_PATENTS, currentPlayer,
+                    g->patents[currentPlayer-1]-1,
+                    g->patents[currentPlayer-1]);
             updateKPI(g, currentPlayer, OBTAIN_IP_PATENT);
         }
     } else if (actionType == RETRAIN_STUDENTS) {
-        int from = a.disciplineFrom;
-        int to = a.disciplineTo;
+        int from = disciplineFrom;
+        int to = disciplineTo;
         g->students[currentPlayer-1][from] -= getExchangeRate(g,
                 currentPlayer, from, to);
         g->students[currentPlayer-1][to]++;
     }
+
+    if (UNI_A <= currentPlayer && currentPlayer <= UNI_C) {
+        hashStudents(g, currentPlayer, studentsBefore);
+    }
+    hashChange(g, HASH_MOST_ARCS, 0, mostARCsBefore, g->mostARCgrants);
+    hashChange(g, HASH_MOST_PUBLICATIONS, 0, mostPublicationsBefore,
+            g->mostPublications);
 }
 
 void throwDice(Game g, int diceScore) {
-    int y = 0;
-    while (y < MAP_REGION_HEIGHT) {
-        int x = 0;
-        while (x < MAP_REGION_WIDTH) {
-            region r = getRegionForCoordinates(g, x, y);
-            if (r.diceValue == diceScore) {
-                // commence calculation
-                // adjacent vertexes are
-                // x, x+1
-                // y, y+1, y+2
-                int yInc = 0;
-                while (yInc < 3) {
-                    int xInc = 0;
-                    while (xInc < 2) {
-                        if (g->vertices[y+yInc][x+xInc] !=
-                                VACANT_VERTEX) {
-                            int owner = g->vertices[y+yInc][x+xInc];
-                            if (owner > 3) { // GO8
-                                g->students[owner-4][r.discipline] += 2;
-                            } else { // normal campus
-                                g->students[owner-1][r.discipline]++;
-                            }
-                        }
-                        xInc++;
-                    }
-                    yInc++;
-                }
-            }
-            x++;
+    uint16_t before[NUM_UNIS][NUM_DISCIPLINE];
+    memcpy(before, g->students, sizeof(before));
+    if (MIN_DICE_VALUE <= diceScore && diceScore <= MAX_DICE_VALUE) {
+        // students and production rows are both NUM_UNIS *
+        // NUM_DISCIPLINE counters laid out the same way
+        uint8_t *gain = &g->production[diceScore-MIN_DICE_VALUE][0][0];
+        uint16_t *students = &g->students[0][0];
+        int i = 0;
+        while (i < NUM_UNIS * NUM_DISCIPLINE) {
+            students[i] += gain[i];
+            i++;
         }
-        y++;
     }
     if (diceScore == 7) {
         int uni = UNI_A;
@@ -321,17 +384,105 @@ void throwDice(Game g, int diceScore) {
             uni++;
         }
     }
+    int uni = UNI_A;
+    while (uni <= UNI_C) {
+        hashStudents(g, uni, before[uni-1]);
+        uni++;
+    }
+
+    int lastTurn = g->whoseTurn;
     g->turnNumber++;
     g->whoseTurn++;
     if (g->whoseTurn > UNI_C) {
         g->whoseTurn = UNI_A;
     }
+    hashChange(g, HASH_TURN, 0, lastTurn, g->whoseTurn);
+}
+
+void makeActionWithUndo(Game g, int actionCode, int target,
+        int disciplineFrom, int disciplineTo, undoRecord *undo) {
+    startUndoRecord(g, undo, UNDO_ACTION);
+    undo->actionCode = actionCode;
+    undo->target = target;
+    undo->exchangeDiscipline = INVALID_ID;
+    if (actionCode == BUILD_CAMPUS) {
+        // remember which exchange rate, if any, the campus lowers
+        uint8_t before[NUM_DISCIPLINE];
+        memcpy(before, g->exchangeRates[undo->player-1], sizeof(before));
+        makeActionAt(g, actionCode, target, disciplineFrom, disciplineTo);
+        int discipline = STUDENT_THD;
+        while (discipline <= STUDENT_MMONEY) {
+            if (before[discipline] !=
+                    g->exchangeRates[undo->player-1][discipline]) {
+                undo->exchangeDiscipline = discipline;
+            }
+            discipline++;
+        }
+    } else {
+        makeActionAt(g, actionCode, target, disciplineFrom, disciplineTo);
+    }
+    finishUndoRecord(g, undo);
+}
+
+void unmakeAction(Game g, const undoRecord *undo) {
+    assert(undo->kind == UNDO_ACTION);
+    int player = undo->player;
+    int actionType = undo->actionCode;
+    undoStudentsAndKPI(g, undo);
+    g->mostARCgrants = undo->mostARCgrants;
+    g->mostPublications = undo->mostPublications;
+
+    if (actionType == BUILD_CAMPUS) {
+        clearVertex(g, undo->target, player);
+        g->campuses[player-1]--;
+        if (undo->exchangeDiscipline != INVALID_ID) {
+            g->exchangeRates[player-1][undo->exchangeDiscipline]++;
+        }
+    } else if (actionType == BUILD_GO8) {
+        clearVertex(g, undo->target, player+3);
+        g->groupOfEights[player-1]--;
+        g->campuses[player-1]++;
+        g->numGO8s--;
+    } else if (actionType == OBTAIN_ARC) {
+        int arcId = undo->target;
+        if (arcId < 64) {
+            g->arcMask[player-1].lo &= ~((uint64_t) 1 << arcId);
+        } else {
+            g->arcMask[player-1].hi &= ~((uint64_t) 1 << (arcId - 64));
+        }
+        g->arcGrants[player-1]--;
+    } else if (actionType == OBTAIN_PUBLICATION) {
+        g->publications[player-1]--;
+    } else if (actionType == OBTAIN_IP_PATENT) {
+        g->patents[player-1]--;
+    }
+    memcpy(g->campusFrontier, undo->campusFrontier,
+            sizeof(g->campusFrontier));
+    memcpy(g->arcFrontier, undo->arcFrontier, sizeof(g->arcFrontier));
+    g->hash = undo->hash;
+}
+
+void throwDiceWithUndo(Game g, int diceScore, undoRecord *undo) {
+    startUndoRecord(g, undo, UNDO_DICE);
+    undo->actionCode = PASS;
+    undo->target = INVALID_ID;
+    undo->exchangeDiscipline = INVALID_ID;
+    throwDice(g, diceScore);
+    finishUndoRecord(g, undo);
+}
+
+void unthrowDice(Game g, const undoRecord *undo) {
+    assert(undo->kind == UNDO_DICE);
+    undoStudentsAndKPI(g, undo);
+    g->turnNumber--;
+    g->whoseTurn = undo->player;
+    g->hash = undo->hash;
 }
 
 // game-wide getter functions
 int getDiscipline(Game g, int regionID) {
     int get = 0;
-    if (0 <= regionID && regionID <= NUM_REGIONS) {
+    if (0 <= regionID && regionID < NUM_REGIONS) {
         get = g->boardTileDisciplines[regionID];
     }
     return get;
@@ -339,12 +490,65 @@ int getDiscipline(Game g, int regionID) {
 
 int getDiceValue(Game g, int regionID) {
     int get = 0;
-    if (0 <= regionID && regionID <= NUM_REGIONS) {
+    if (0 <= regionID && regionID < NUM_REGIONS) {
         get = g->boardTileDice[regionID];
     }
     return get;
 }
 
+uint64_t getStateHash(Game g) {
+    return g->hash;
+}
+
+uint64_t getBoardHash(Game g) {
+    return g->boardHash;
+}
+
+uint64_t getCanonicalHash(Game g) {
+    int mover = g->whoseTurn;
+    uint64_t hash = zobristKey(HASH_MOST_ARCS, 0,
+                relabel(g->mostARCgrants, mover)) ^
+            zobristKey(HASH_MOST_PUBLICATIONS, 0,
+                relabel(g->mostPublications, mover)) ^
+            zobristKey(HASH_GO8_COUNT, 0, g->numGO8s);
+    int uni = UNI_A;
+    while (uni <= UNI_C) {
+        int seat = relabel(uni, mover);
+        uint64_t campuses = g->campusMask[uni-1];
+        while (campuses != 0) {
+            int vertex = lowestBit(campuses);
+            int contents = seat;
+            if (g->go8Mask & ((uint64_t) 1 << vertex)) {
+                contents += NUM_UNIS;
+            }
+            hash ^= zobristKey(HASH_VERTEX, vertex, contents);
+            campuses &= campuses - 1;
+        }
+        uint64_t arcs = g->arcMask[uni-1].lo;
+        while (arcs != 0) {
+            hash ^= zobristKey(HASH_ARC, lowestBit(arcs), seat);
+            arcs &= arcs - 1;
+        }
+        arcs = g->arcMask[uni-1].hi;
+        while (arcs != 0) {
+            hash ^= zobristKey(HASH_ARC, 64 + lowestBit(arcs), seat);
+            arcs &= arcs - 1;
+        }
+        int discipline = STUDENT_THD;
+        while (discipline <= STUDENT_MMONEY) {
+            hash ^= zobristKey(HASH_STUDENTS,
+                    (seat-1) * NUM_DISCIPLINE + discipline,
+                    g->students[uni-1][discipline]);
+            discipline++;
+        }
+        hash ^= zobristKey(HASH_PATENTS, seat, g->patents[uni-1]);
+        hash ^= zobristKey(HASH_PUBLICATIONS, seat,
+                g->publications[uni-1]);
+        uni++;
+    }
+    return hash;
+}
+
 int getMostARCs(Game g) {
     return g->mostARCgrants;
 }
@@ -362,21 +566,41 @@ int getWhoseTurn(Game g) {
 }
 
 int getCampus(Game g, path pathToVertex) {
-    int get = 0;
-    coord vertex = getVertexCoordinateFromPath(pathToVertex);
-    if (0 <= vertex.y && vertex.y <= MAP_VERTEX_HEIGHT &&
-            0 <= vertex.x && vertex.x <= MAP_VERTEX_WIDTH) {
-        get = g->vertices[vertex.y][vertex.x];
+    return getCampusAt(g, pathToVertexId(pathToVertex));
+}
+
+int getARC(Game g, path pathToEdge) {
+    return getArcAt(g, pathToArcId(pathToEdge));
+}
+
+int getCampusAt(Game g, int vertexId) {
+    int get = VACANT_VERTEX;
+    if (0 <= vertexId && vertexId < NUM_VERTICES) {
+        uint64_t bit = (uint64_t) 1 << vertexId;
+        int uni = UNI_A;
+        while (uni <= UNI_C) {
+            if (g->campusMask[uni-1] & bit) {
+                get = uni;
+                if (g->go8Mask & bit) {
+                    get += NUM_UNIS;
+                }
+            }
+            uni++;
+        }
     }
     return get;
 }
 
-int getARC(Game g, path pathToEdge) {
-    int get = 0;
-    coord arc = getARCCoordinateFromPath(pathToEdge);
-    if (0 <= arc.y && arc.y <= MAP_ARC_HEIGHT &&
-            0 <= arc.x && arc.x <= MAP_ARC_WIDTH) {
-        get = g->arcs[arc.y][arc.x];
+int getArcAt(Game g, int arcId) {
+    int get = VACANT_ARC;
+    if (0 <= arcId && arcId < NUM_ARCS) {
+        int uni = UNI_A;
+        while (uni <= UNI_C) {
+            if (arcSetHas(g->arcMask[uni-1], arcId)) {
+                get = uni;
+            }
+            uni++;
+        }
     }
     return get;
 }
@@ -384,39 +608,46 @@ int getARC(Game g, path pathToEdge) {
 // returns TRUE if action 'a' is legal for current player.
 // always FALSE in terra nullius
 int isLegalAction(Game g, action a) {
+    return isLegalActionAt(g, a.actionCode, decodeTarget(a.actionCode,
+            a.destination), a.disciplineFrom, a.disciplineTo);
+}
+
+// the disciplines of a move that isn't a retraining are nonsense, but
+// isLegalActionAt() never looks at them
+int isLegalMove(Game g, move m) {
+    return isLegalActionAt(g, MOVE_CODE(m), moveTarget(m), MOVE_FROM(m),
+            MOVE_TO(m));
+}
+
+int isLegalActionAt(Game g, int actionCode, int target,
+        int disciplineFrom, int disciplineTo) {
     int isLegal = FALSE;
     int player = getWhoseTurn(g);
-    //printf("I'm inside isLegalAction\n");
     if (getTurnNumber(g) != -1) {
-        //printf("turn number ok\n");
-        int actionType = a.actionCode;
+        int actionType = actionCode;
         if (actionType == PASS) {
             isLegal = TRUE;
         } else if (actionType == BUILD_CAMPUS) {
-            coord vertex = getVertexCoordinateFromPath(a.destination);
-
-            if (vertex.x >= 0 && vertex.y >= 0) {
+            if (0 <= target && target < NUM_VERTICES) {
                 // check there's no campus there and the player has an
                 // adjacent arc
-                if (getCampus(g, a.destination) == VACANT_VERTEX &&
-                        ownsARCborderingVertex(g, vertex, player)) {
+                if (getCampusAt(g, target) == VACANT_VERTEX &&
+                        ownsARCborderingVertex(g, target, player)) {
                     // and the player has the right resources
                     if (getStudents(g, player, STUDENT_BQN) >= 1 &&
                             getStudents(g, player, STUDENT_BPS) >= 1 &&
                             getStudents(g, player, STUDENT_MJ) >= 1 &&
                             getStudents(g, player, STUDENT_MTV) >= 1) {
                         // and there's not a campus adjacent
-                        if (!isCampusAdjacent(g, vertex)) {
+                        if (!isCampusAdjacent(g, target)) {
                             isLegal = TRUE;
                         }
                     }
                 }
             }
         } else if (actionType == BUILD_GO8) {
-            coord vertex = getVertexCoordinateFromPath(a.destination);
-
-            if (vertex.x >= 0 && vertex.y >= 0) {
-                int campusType = getCampus(g, a.destination);
+            if (0 <= target && target < NUM_VERTICES) {
+                int campusType = getCampusAt(g, target);
                 // check there is a campus there and there are less than
                 // 8 existing GO8 campuses
                 if (campusType == player && g->numGO8s < 8) {
@@ -428,22 +659,19 @@ int isLegalAction(Game g, action a) {
                 }
             }
         } else if (actionType == OBTAIN_ARC) {
-            //printf("I AM ABOUT TO RUN THIS THING\n");
-            coord arc = getARCCoordinateFromPath(a.destination);
-            //printf("testing coords...\n");
-            if (arc.x >= 0 && arc.y >= 0) {
+            if (0 <= target && target < NUM_ARCS) {
                 // the player has an arc leading to this pointor a
                 // campus adjacent to the arc and that the arc is not
                 // occupied
                 #ifdef DEBUG
-                printf("coords are ok - %d, %d\n", arc.x, arc.y);
+                printf("arc is ok - %d\n", target);
                 #endif
-                if ((ownsARCadjacentTo(g, arc, player) ||
-                        ownsVertexBorderingARC(g, arc, player))) {
+                if ((ownsARCadjacentTo(g, target, player) ||
+                        ownsVertexBorderingARC(g, target, player))) {
                     #ifdef DEBUG
                     printf("adjacents ok\n");
                     #endif
-                    if (getARC(g, a.destination) == VACANT_ARC) {
+                    if (getArcAt(g, target) == VACANT_ARC) {
                         #ifdef DEBUG
                         printf("arc is vacant\n");
                         #endif
@@ -456,10 +684,7 @@ int isLegalAction(Game g, action a) {
                             #endif
                             isLegal = TRUE;
                         }
-                    } /*else {
-                        printf("arc is not vacant: occupied by %d\n",
-                                getARC(g, a.destination));
-                    }*/
+                    }
                 }
             }
         } else if (actionType == START_SPINOFF) {
@@ -469,8 +694,8 @@ int isLegalAction(Game g, action a) {
                 isLegal = TRUE;
             }
         } else if (actionType == RETRAIN_STUDENTS) {
-            int from = a.disciplineFrom;
-            int to = a.disciplineTo;
+            int from = disciplineFrom;
+            int to = disciplineTo;
             if (STUDENT_THD <= from && from <= STUDENT_MMONEY &&
                     STUDENT_THD <= to && to <= STUDENT_MMONEY) {
                 if (from != STUDENT_THD &&
@@ -484,6 +709,135 @@ int isLegalAction(Game g, action a) {
     return isLegal;
 }
 
+int generateLegalActions(Game g, move buffer[], int cap) {
+    int found = 0;
+    uint64_t campusSites;
+    uint64_t go8Sites;
+    arcSet arcSlots;
+    findLegalTargets(g, &campusSites, &go8Sites, &arcSlots);
+
+    while (campusSites != 0) {
+        if (found < cap) {
+            buffer[found] = ENCODE_MOVE(BUILD_CAMPUS,
+                    lowestBit(campusSites));
+        }
+        found++;
+        campusSites &= campusSites - 1;
+    }
+    while (go8Sites != 0) {
+        if (found < cap) {
+            buffer[found] = ENCODE_MOVE(BUILD_GO8, lowestBit(go8Sites));
+        }
+        found++;
+        go8Sites &= go8Sites - 1;
+    }
+    while (arcSlots.lo != 0) {
+        if (found < cap) {
+            buffer[found] = ENCODE_MOVE(OBTAIN_ARC,
+                    lowestBit(arcSlots.lo));
+        }
+        found++;
+        arcSlots.lo &= arcSlots.lo - 1;
+    }
+    while (arcSlots.hi != 0) {
+        if (found < cap) {
+            buffer[found] = ENCODE_MOVE(OBTAIN_ARC,
+                    64 + lowestBit(arcSlots.hi));
+        }
+        found++;
+        arcSlots.hi &= arcSlots.hi - 1;
+    }
+
+    if (isLegalActionAt(g, START_SPINOFF, INVALID_ID, 0, 0)) {
+        if (found < cap) {
+            buffer[found] = ENCODE_MOVE(START_SPINOFF, 0);
+        }
+        found++;
+    }
+
+    int player = getWhoseTurn(g);
+    int from = STUDENT_BPS;
+    while (from <= STUDENT_MMONEY) {
+        if (canRetrainFrom(g, player, from)) {
+            int to = STUDENT_THD;
+            while (to <= STUDENT_MMONEY) {
+                if (found < cap) {
+                    buffer[found] = ENCODE_RETRAIN(from, to);
+                }
+                found++;
+                to++;
+            }
+        }
+        from++;
+    }
+    return found;
+}
+
+int countLegalActions(Game g) {
+    uint64_t campusSites;
+    uint64_t go8Sites;
+    arcSet arcSlots;
+    findLegalTargets(g, &campusSites, &go8Sites, &arcSlots);
+
+    int count = popCount(campusSites) + popCount(go8Sites) +
+            popCount(arcSlots.lo) + popCount(arcSlots.hi);
+    if (isLegalActionAt(g, START_SPINOFF, INVALID_ID, 0, 0)) {
+        count++;
+    }
+    int player = getWhoseTurn(g);
+    int from = STUDENT_BPS;
+    while (from <= STUDENT_MMONEY) {
+        if (canRetrainFrom(g, player, from)) {
+            count += NUM_DISCIPLINE;
+        }
+        from++;
+    }
+    return count;
+}
+
+uint64_t getCampusFrontier(Game g, int player) {
+    uint64_t get = 0;
+    if (UNI_A <= player && player <= UNI_C) {
+        get = g->campusFrontier[player-1];
+    }
+    return get;
+}
+
+arcSet getArcFrontier(Game g, int player) {
+    arcSet get = {0, 0};
+    if (UNI_A <= player && player <= UNI_C) {
+        get = g->arcFrontier[player-1];
+    }
+    return get;
+}
+
+int listCampusFrontier(Game g, int player, int vertexIdsOut[]) {
+    int found = 0;
+    uint64_t bits = getCampusFrontier(g, player);
+    while (bits != 0) {
+        vertexIdsOut[found] = lowestBit(bits);
+        found++;
+        bits &= bits - 1;
+    }
+    return found;
+}
+
+int listArcFrontier(Game g, int player, int arcIdsOut[]) {
+    int found = 0;
+    arcSet arcs = getArcFrontier(g, player);
+    while (arcs.lo != 0) {
+        arcIdsOut[found] = lowestBit(arcs.lo);
+        found++;
+        arcs.lo &= arcs.lo - 1;
+    }
+    while (arcs.hi != 0) {
+        arcIdsOut[found] = 64 + lowestBit(arcs.hi);
+        found++;
+        arcs.hi &= arcs.hi - 1;
+    }
+    return found;
+}
+
 // player getter functions
 
 int getKPIpoints(Game g, int player) {
@@ -552,21 +906,6 @@ int getExchangeRate (Game g, int player, int disciplineFrom,
 }
 
 // "private" functions (sick OO C)
-static int isValidRegion(int x, int y) {
-    // needs documentation
-    int valid = TRUE;
-    if (y > 8 || y < 0 || x < 0 || x > 4) {
-        valid = FALSE;
-    } else if (y == 0 && x != 2) {
-        valid = FALSE;
-    } else if ((y == 1 || y == 8) && (x == 0 || x == 4)) {
-        valid = FALSE;
-    } else if (x % 2 != y % 2) {
-        valid = FALSE;
-    }
-    return valid;
-}
-
 // determines if the player has the most ARC grants. mostARCgrants in
 // struct _game is NOT used NOR updated
 static int hasMostARCgrants(Game g, int player) {
@@ -599,10 +938,6 @@ static int hasMostPublications(Game g, int player) {
     return mostPublications;
 }
 
-static region getRegionForCoordinates(Game g, int x, int y) {
-    return g->regions[y][x];
-}
-
 // updateKPI must run AFTER the action has been successfully executed
 // side effects: updateKPI also updates mostARCgrants and
 // mostPublications where relevant
@@ -648,404 +983,479 @@ static void updateKPI(Game g, int player, int actionCode) {
     g->kpi[player-1] += kpi;
 }
 
-static void updateArc(Game g, int x, int y, int newValue) {
-    assert(y < MAP_ARC_HEIGHT);
-    assert(x < MAP_ARC_WIDTH);
+static void updateArc(Game g, int arcId, int newValue) {
+    assert(0 <= arcId && arcId < NUM_ARCS);
+    assert(UNI_A <= newValue && newValue <= UNI_C);
+
+    arcSetAdd(&g->arcMask[newValue-1], arcId);
+    hashChange(g, HASH_ARC, arcId, VACANT_ARC, newValue);
 
-    // TODO assert newValue is valid
-    g->arcs[y][x] = newValue;
-    //printf("SET ARC %d,%d TO %d\n", x, y, newValue);
+    // the ARC is no longer anyone's to take, but the vacant ARCs next
+    // to it and the free vertices at its ends are now in reach
+    int uni = UNI_A;
+    while (uni <= UNI_C) {
+        arcSetRemove(&g->arcFrontier[uni-1], arcId);
+        uni++;
+    }
+    arcSet vacant = vacantArcs(g);
+    arcSet *frontier = &g->arcFrontier[newValue-1];
+    frontier->lo |= arcNeighbours[arcId].lo & vacant.lo;
+    frontier->hi |= arcNeighbours[arcId].hi & vacant.hi;
+
+    uint64_t occupied = occupiedVertices(g);
+    uint64_t ends = arcEnds[arcId];
+    while (ends != 0) {
+        int vertex = lowestBit(ends);
+        if ((occupied & (((uint64_t) 1 << vertex) |
+                vertexNeighbours[vertex])) == 0) {
+            g->campusFrontier[newValue-1] |= (uint64_t) 1 << vertex;
+        }
+        ends &= ends - 1;
+    }
 }
-static void updateVertex(Game g, int x, int y, int newValue) {
-    assert(y < MAP_VERTEX_HEIGHT);
-    assert(x < MAP_VERTEX_WIDTH);
 
-    // TODO assert newValue is valid
+// newValue is always a new campus or a campus being upgraded to a
+// GO8. both mean one more student from every adjacent region, so the
+// production table is updated here too.
+static void updateVertex(Game g, int vertexId, int newValue) {
+    assert(0 <= vertexId && vertexId < NUM_VERTICES);
+    assert(CAMPUS_A <= newValue && newValue <= GO8_C);
+
+    uint64_t bit = (uint64_t) 1 << vertexId;
+    if (newValue > CAMPUS_C) {
+        g->go8Mask |= bit;
+        hashChange(g, HASH_VERTEX, vertexId, newValue - NUM_UNIS,
+                newValue);
+    } else {
+        g->campusMask[newValue-1] |= bit;
+        hashChange(g, HASH_VERTEX, vertexId, VACANT_VERTEX, newValue);
 
-    g->vertices[y][x] = newValue;
+        // nobody can build on or next to a new campus, and its owner
+        // can reach the vacant ARCs around it
+        uint64_t blocked = bit | vertexNeighbours[vertexId];
+        int uni = UNI_A;
+        while (uni <= UNI_C) {
+            g->campusFrontier[uni-1] &= ~blocked;
+            uni++;
+        }
+        arcSet vacant = vacantArcs(g);
+        arcSet *frontier = &g->arcFrontier[newValue-1];
+        frontier->lo |= vertexArcs[vertexId].lo & vacant.lo;
+        frontier->hi |= vertexArcs[vertexId].hi & vacant.hi;
+    }
+
+    int owner = newValue;
+    if (owner > UNI_C) {
+        owner -= NUM_UNIS;
+    }
+    updateProduction(g, vertexId, owner, 1);
 }
 
-static int isValidVertex(int x, int y) {
-    int valid = TRUE;
-    if (x > 5 || x < 0 || y < 0 || y > 10) {
-        valid = FALSE;
-    } else if ((y == 0 || y == 10) && !(x == 2 || x == 3)) {
-        valid = FALSE;
-    } else if ((y == 1 || y == 9) && (x == 0 || x == 5)) {
-        valid = FALSE;
+// takes a campus (or the GO8 part of a GO8) back off a vertex. only
+// used to undo updateVertex()
+static void clearVertex(Game g, int vertexId, int oldValue) {
+    uint64_t bit = (uint64_t) 1 << vertexId;
+    int owner = oldValue;
+    if (oldValue > CAMPUS_C) {
+        g->go8Mask &= ~bit;
+        owner -= NUM_UNIS;
+    } else {
+        g->campusMask[oldValue-1] &= ~bit;
     }
-    return valid;
+    updateProduction(g, vertexId, owner, -1);
 }
 
-static int isValidARC(int x, int y) {
-    int valid = TRUE;
-    // (odd, odd) and (even, even) arcs don't exist
-    if (y % 2 == x % 2) {
-        valid = FALSE;
-    } else if (y % 2 == 0 && x % 2 == 1) {
-        // if y divisible by four
-        // x 3 and 7 will be invalid
-        // else, x 1 5 and 9 will be invalid
-        if (y % 4 == 0) {
-            if (x == 3 || x == 7) {
-                valid = FALSE;
-            }
-        } else {
-            if (x == 1 || x == 5 || x == 9) {
-                valid = FALSE;
-            }
+// adds amount students per roll to the production table for every
+// region next to the vertex
+static void updateProduction(Game g, int vertexId, int player,
+        int amount) {
+    int i = vertexRegionStart[vertexId];
+    while (i < vertexRegionStart[vertexId+1]) {
+        int regionID = vertexRegionList[i];
+        int diceValue = g->boardTileDice[regionID];
+        if (MIN_DICE_VALUE <= diceValue && diceValue <= MAX_DICE_VALUE) {
+            g->production[diceValue-MIN_DICE_VALUE][player-1]
+                    [g->boardTileDisciplines[regionID]] += amount;
+        }
+        i++;
+    }
+}
+
+// a pseudo random key for each (kind, index, value). the keys are
+// generated on the fly with splitmix64 rather than stored, so any
+// counter value gets its own key
+static uint64_t zobristKey(int kind, int index, int value) {
+    uint64_t z = ((uint64_t) kind << 48) ^ ((uint64_t) index << 32) ^
+            (uint32_t) value;
+    z += 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// swaps the key for oldValue out of the hash and the key for newValue
+// in. vacant vertices and ARCs are never in the hash, so VACANT_*
+// as oldValue just adds the new key
+static void hashChange(Game g, int kind, int index, int oldValue,
+        int newValue) {
+    if (oldValue != newValue) {
+        if (!((kind == HASH_VERTEX || kind == HASH_ARC) &&
+                oldValue == VACANT_VERTEX)) {
+            g->hash ^= zobristKey(kind, index, oldValue);
+        }
+        g->hash ^= zobristKey(kind, index, newValue);
+    }
+}
+
+static void hashStudents(Game g, int player,
+        const uint16_t before[NUM_DISCIPLINE]) {
+    int discipline = STUDENT_THD;
+    while (discipline <= STUDENT_MMONEY) {
+        hashChange(g, HASH_STUDENTS,
+                (player-1) * NUM_DISCIPLINE + discipline,
+                before[discipline], g->students[player-1][discipline]);
+        discipline++;
+    }
+}
+
+// the hash worked out from scratch. only needed when a game is made
+static uint64_t computeStateHash(Game g) {
+    uint64_t hash = zobristKey(HASH_TURN, 0, g->whoseTurn) ^
+            zobristKey(HASH_MOST_ARCS, 0, g->mostARCgrants) ^
+            zobristKey(HASH_MOST_PUBLICATIONS, 0, g->mostPublications) ^
+            zobristKey(HASH_GO8_COUNT, 0, g->numGO8s);
+    int vertex = 0;
+    while (vertex < NUM_VERTICES) {
+        int contents = getCampusAt(g, vertex);
+        if (contents != VACANT_VERTEX) {
+            hash ^= zobristKey(HASH_VERTEX, vertex, contents);
+        }
+        vertex++;
+    }
+    int arc = 0;
+    while (arc < NUM_ARCS) {
+        int contents = getArcAt(g, arc);
+        if (contents != VACANT_ARC) {
+            hash ^= zobristKey(HASH_ARC, arc, contents);
+        }
+        arc++;
+    }
+    int uni = UNI_A;
+    while (uni <= UNI_C) {
+        int discipline = STUDENT_THD;
+        while (discipline <= STUDENT_MMONEY) {
+            hash ^= zobristKey(HASH_STUDENTS,
+                    (uni-1) * NUM_DISCIPLINE + discipline,
+                    g->students[uni-1][discipline]);
+            discipline++;
         }
+        hash ^= zobristKey(HASH_PATENTS, uni, g->patents[uni-1]);
+        hash ^= zobristKey(HASH_PUBLICATIONS, uni,
+                g->publications[uni-1]);
+        uni++;
+    }
+    return hash;
+}
+
+// the label player gets when the universities are renamed so that
+// mover becomes UNI_A and turn order is kept. NO_ONE stays NO_ONE,
+// and so does everyone before the first turn
+static int relabel(int player, int mover) {
+    int label = player;
+    if (player != NO_ONE && mover != NO_ONE) {
+        label = (player - mover + NUM_UNIS) % NUM_UNIS + 1;
     }
+    return label;
+}
 
-    if ((x <= 1 || x >= 9) && (y < 4 || y > 16)) { // outside board
-        valid = FALSE;
-    } else if ((x < 4 || x > 6) && (y > 18 || y < 2)) {
-        valid = FALSE;
+// the undo record first holds the students and KPIs from before the
+// change, which finishUndoRecord() turns into deltas
+static void startUndoRecord(Game g, undoRecord *undo, int kind) {
+    undo->kind = kind;
+    undo->hash = g->hash;
+    memcpy(undo->campusFrontier, g->campusFrontier,
+            sizeof(undo->campusFrontier));
+    memcpy(undo->arcFrontier, g->arcFrontier, sizeof(undo->arcFrontier));
+    undo->player = g->whoseTurn;
+    undo->mostARCgrants = g->mostARCgrants;
+    undo->mostPublications = g->mostPublications;
+    int uni = UNI_A;
+    while (uni <= UNI_C) {
+        int discipline = STUDENT_THD;
+        while (discipline <= STUDENT_MMONEY) {
+            undo->studentDeltas[uni-1][discipline] =
+                    g->students[uni-1][discipline];
+            discipline++;
+        }
+        undo->kpiDeltas[uni-1] = g->kpi[uni-1];
+        uni++;
+    }
+}
+
+static void finishUndoRecord(Game g, undoRecord *undo) {
+    int uni = UNI_A;
+    while (uni <= UNI_C) {
+        int discipline = STUDENT_THD;
+        while (discipline <= STUDENT_MMONEY) {
+            undo->studentDeltas[uni-1][discipline] =
+                    g->students[uni-1][discipline] -
+                    undo->studentDeltas[uni-1][discipline];
+            discipline++;
+        }
+        undo->kpiDeltas[uni-1] = g->kpi[uni-1] - undo->kpiDeltas[uni-1];
+        uni++;
     }
+}
 
-    if (x > 10 || x < 0 || y < 0 || y > 20) {
-        valid = FALSE;
+static void undoStudentsAndKPI(Game g, const undoRecord *undo) {
+    int uni = UNI_A;
+    while (uni <= UNI_C) {
+        int discipline = STUDENT_THD;
+        while (discipline <= STUDENT_MMONEY) {
+            g->students[uni-1][discipline] -=
+                    undo->studentDeltas[uni-1][discipline];
+            discipline++;
+        }
+        g->kpi[uni-1] -= undo->kpiDeltas[uni-1];
+        uni++;
     }
-    return valid;
 }
 
-static int isValidAction(Game g, action a) {
+static int isValidActionAt(Game g, int actionCode, int target,
+        int disciplineFrom, int disciplineTo) {
     int isValid = FALSE;
 
-    int actionType = a.actionCode;
+    int actionType = actionCode;
     if (actionType == PASS ||
             actionType == BUILD_CAMPUS ||
             actionType == BUILD_GO8 ||
             actionType == OBTAIN_ARC ||
             actionType == RETRAIN_STUDENTS) {
-        isValid = isLegalAction(g, a);
+        isValid = isLegalActionAt(g, actionCode, target, disciplineFrom,
+                disciplineTo);
     } else if (actionType == OBTAIN_IP_PATENT ||
             actionType == OBTAIN_PUBLICATION) {
-        action spinoff = {START_SPINOFF, "", 0, 0};
-        isValid = isLegalAction(g, spinoff);
+        isValid = isLegalActionAt(g, START_SPINOFF, INVALID_ID, 0, 0);
     }
     return isValid;
 }
 
-static coord getVertexCoordinateFromPath(path p) {
-    return getCoordinateFromPath(p, FALSE);
+// decodes the destination of an action into the ID it operates on so
+// the path is only walked once per action
+static int decodeTarget(int actionCode, path p) {
+    int target = INVALID_ID;
+    if (actionCode == BUILD_CAMPUS || actionCode == BUILD_GO8) {
+        target = pathToVertexId(p);
+    } else if (actionCode == OBTAIN_ARC) {
+        target = pathToArcId(p);
+    }
+    return target;
 }
 
-static coord getARCCoordinateFromPath(path p) {
-    return getCoordinateFromPath(p, TRUE);
+move actionToMove(action a) {
+    int target = 0;
+    if (a.actionCode == RETRAIN_STUDENTS) {
+        target = MOVE_NO_TARGET;
+        if (STUDENT_THD <= a.disciplineFrom &&
+                a.disciplineFrom <= STUDENT_MMONEY &&
+                STUDENT_THD <= a.disciplineTo &&
+                a.disciplineTo <= STUDENT_MMONEY) {
+            target = a.disciplineFrom * 8 + a.disciplineTo;
+        }
+    } else if (a.actionCode == BUILD_CAMPUS ||
+            a.actionCode == BUILD_GO8 || a.actionCode == OBTAIN_ARC) {
+        target = decodeTarget(a.actionCode, a.destination);
+        if (target == INVALID_ID) {
+            target = MOVE_NO_TARGET;
+        }
+    }
+    return ENCODE_MOVE(a.actionCode, target);
 }
 
-static coord getCoordinateFromPath(path p, int getArcCoord) {
-    int len = (int) strlen(p);
-    #ifdef DEBUG
-    printf("\n\n====== NEW PATH '%s' =====\n\n", p);
-    #endif
-    int i = 0;
-    coord result;
-    result.x = 2;
-    result.y = 0;
-    coord prevStop;
-    prevStop.x = 1;
-    prevStop.y = -1;
-    while (i < len && isValidVertex(result.x, result.y)) {
-        #ifdef DEBUG
-        printf(" %03d of %03d - currently at (%d, %d) - previously"
-                "(%d, %d) ", i+1, len, result.x, result.y, prevStop.x,
-                prevStop.y);
-        #endif
-        char step = p[i];
-        int newX = result.x;
-        int newY = result.y;
-
-        if (step == 'B') {
-            if (i == 0) {
-                result.x = -1;
-                result.y = -1;
-                step = 'Z';
-            } else {
-                // go back
-                #ifdef DEBUG
-                printf("B");
-                #endif
-                newX = prevStop.x;
-                newY = prevStop.y;
-                prevStop.x = result.x;
-                prevStop.y = result.y;
-                result.x = newX;
-                result.y = newY;
-            }
-        } else if (step == 'L') {
-            #ifdef DEBUG
-            printf("L");
-            #endif
-            // work out which way is left
-            // and change newX and newY
-            if (result.y == prevStop.y) {
-                // changing the y value
-                if (result.x < prevStop.x) {
-                    // facing towards the y axis
-                    // so we're going down - tested in tests
-                    #ifdef DEBUG
-                    printf("[down]");
-                    #endif
-                    newY += 1;
-                } else {
-                    // going up - tested
-                    #ifdef DEBUG
-                    printf("[up]");
-                    #endif
-                    newY -= 1;
-                }
-            } else if (result.x == prevStop.x) {
-                // changing the x value
-                if (result.y < prevStop.y) {
-                    // facing towards the x axis
-                    // so we're going toward the y axis
-                    if (result.y % 2 == result.x % 2) {
-                        #ifdef DEBUG
-                        printf("[up.]");
-                        #endif
-                        newY -= 1;
-                    } else {
-                        #ifdef DEBUG
-                        printf("[left.]");
-                        #endif
-                        newX -= 1;
-                    }
-                } else {
-                    if ((result.y % 2 != result.x % 2) ||
-                            (result.x == 5 && result.y % 2 == 0)) {
-                        #ifdef DEBUG
-                        printf("[down!]");
-                        #endif
-                        newY += 1;
-                    } else {
-                        #ifdef DEBUG
-                        printf("[right!]");
-                        #endif
-                        newX += 1;
-                    }
-                }
-
-            } else {
-                // this should only occur on the first step.
-                // DEBUG: printf("*1");
-                if (i != 0) {
-                    printf("ERROR: NOT ON FIRST STEP\n");
-                }
-                newY = 0;
-                newX = 3;
-            }
-            // and update the variables
-            prevStop.y = result.y;
-            prevStop.x = result.x;
-            result.y = newY;
-            result.x = newX;
-        } else if (step == 'R') {
-            #ifdef DEBUG
-            printf("R");
-            #endif
-            if (result.y == prevStop.y) {
-                // chainging the y value
-                if (result.x < prevStop.x) {
-                    // facing the y axis, so going up
-                    #ifdef DEBUG
-                    printf("[up]");
-                    #endif
-                    newY -= 1;
-                } else {
-                    newY += 1;
-                    #ifdef DEBUG
-                    printf("[down]");
-                    #endif
-                }
-            } else if (result.x == prevStop.x) {
-                // changing the x value
-                if (result.y < prevStop.y) {
-                    // facing the x axis
-                    // going away from the y axis
-                    if (result.x % 2 != result.y % 2) {
-                        #ifdef DEBUG
-                        printf("[up!!]");
-                        #endif
-                        newY -= 1;
-                    } else {
-                        #ifdef DEBUG
-                        printf("[right!!]");
-                        #endif
-                        newX += 1;
-                    }
-                } else {
-                    if ((result.x % 2 == result.y % 2)) {
-                        #ifdef DEBUG
-                        printf("[down!!]");
-                        #endif
-                        newY += 1;
-                    } else {
-                        #ifdef DEBUG
-                        printf("[left!!]");
-                        #endif
-                        newX -= 1;
-                    }
-                }
-            } else {
-                // only on first step!
-                if (i != 0) {
-                    printf("ERROR: NOT ON FIRST STEP\n");
-                }
-                // DEBUG: printf("*1");
-                newY = 1;
-                newX = 2;
-            }
-            // and update the variables
-            prevStop.y = result.y;
-            prevStop.x = result.x;
-            result.y = newY;
-            result.x = newX;
+action moveToAction(move m) {
+    action a;
+    memset(&a, 0, sizeof(action));
+    a.actionCode = MOVE_CODE(m);
+    int target = MOVE_TARGET(m);
+    if (a.actionCode == BUILD_CAMPUS || a.actionCode == BUILD_GO8) {
+        // going back from the start leaves the island
+        if (target < NUM_VERTICES) {
+            strcpy(a.destination, vertexPaths[target]);
+        } else {
+            strcpy(a.destination, "B");
+        }
+    } else if (a.actionCode == OBTAIN_ARC) {
+        if (target < NUM_ARCS) {
+            strcpy(a.destination, arcPaths[target]);
         } else {
-            result.y = -1;
-            result.x = -1;
-            step = 'Z';
+            strcpy(a.destination, "B");
         }
+    } else if (a.actionCode == RETRAIN_STUDENTS) {
+        a.disciplineFrom = MOVE_FROM(m);
+        a.disciplineTo = MOVE_TO(m);
+    }
+    return a;
+}
+
+// the ID a move operates on, or INVALID_ID if it is off the island
+static int moveTarget(move m) {
+    int target = MOVE_TARGET(m);
+    if (target == MOVE_NO_TARGET) {
+        target = INVALID_ID;
+    }
+    return target;
+}
+
+int pathToVertexId(path p) {
+    return pathStateVertex[decodePathState(p)];
+}
+
+int pathToArcId(path p) {
+    return pathStateArc[decodePathState(p)];
+}
 
-        #ifdef DEBUG
-        printf(" (%d,%d)", result.x, result.y);
-        printf("\n");
-        #endif
+static int decodePathState(const char *p) {
+    int state = PATH_STATE_START;
+    int i = 0;
+    while (p[i] != 0) {
+        state = pathTransitions[state][stepClasses[(unsigned char) p[i]]];
         i++;
     }
-    if (!isValidVertex(result.x, result.y)) {
-        result.x = -1;
-        result.y = -1;
-        //printf("INVALID!\n");
-    } else if (getArcCoord) {
-        // convert both coordinate pairs into arcs -
-        // the arc returned is the last arc traversed in the path.
-        result.x *= 2;
-        result.y *= 2;
-        prevStop.x *= 2;
-        prevStop.y *= 2;
-        // and now average them out
-        result.x = (result.x + prevStop.x) / 2;
-        result.y = (result.y + prevStop.y) / 2;
-    }
-    #ifdef DEBUG
-    printf("ended at (%d,%d)\n", result.x, result.y);
-    #endif
-    return result;
-}
-
-static int ownsARCborderingVertex(Game g, coord vertex, int player) {
-    int y = vertex.y * 2;
-    int x = vertex.x * 2;
-    // either side
-    int result = FALSE;
-    if (g->arcs[y][x-1] == player || g->arcs[y][x+1] == player ||
-        g->arcs[y-1][x] == player || g->arcs[y+1][x] == player) {
-        result = TRUE;
-    }
-    return result;
-}
-
-static int ownsARCadjacentTo(Game g, coord arc, int player) {
-    int y = arc.y;
-    int x = arc.x;
-    int result = FALSE;
-    if (isValidARC(x+1, y-1) && g->arcs[y-1][x+1] == player) {
-        result = TRUE;
-    } else if (isValidARC(x-1, y-1) && g->arcs[y-1][x-1] == player) {
-        result = TRUE;
-    } else if (isValidARC(x+1, y+1) && g->arcs[y+1][x+1] == player) {
-        result = TRUE;
-    } else if (isValidARC(x-1, y+1) && g->arcs[y+1][x-1] == player) {
-        result = TRUE;
-    } else if (isValidARC(x, y+2) && g->arcs[y+2][x] == player) {
-        result = TRUE;
-    } else if (isValidARC(x, y-2) && g->arcs[y-2][x] == player) {
-        result = TRUE;
-    }
-    return result;
-}
-
-static int ownsVertexBorderingARC(Game g, coord arc, int player) {
-    int y = arc.y;
-    int x = arc.x;
-    // vertices are at an (even, even) point.
-    int yDiff = y % 2;
-    int xDiff = x % 2;
-    int result = FALSE;
-    if (yDiff > 0) {
-        x = x/2;
-        y++;
-        if (g->vertices[y/2][x] == player ||
-            g->vertices[y/2][x] == player+3) {
-            result = TRUE;
+    return state;
+}
+
+// decodes four paths at a time in lockstep. a lane that has reached
+// its terminator keeps feeding STEP_END, which leaves its state alone,
+// so the inner loop has no per lane branches and the four table
+// lookups are independent of each other
+void decodePaths(path paths[], int n, int vertexIdsOut[],
+        int arcIdsOut[]) {
+    int i = 0;
+    while (i + 4 <= n) {
+        const unsigned char *p0 = (const unsigned char *) paths[i];
+        const unsigned char *p1 = (const unsigned char *) paths[i+1];
+        const unsigned char *p2 = (const unsigned char *) paths[i+2];
+        const unsigned char *p3 = (const unsigned char *) paths[i+3];
+        int s0 = PATH_STATE_START;
+        int s1 = PATH_STATE_START;
+        int s2 = PATH_STATE_START;
+        int s3 = PATH_STATE_START;
+        while ((*p0 | *p1 | *p2 | *p3) != 0) {
+            s0 = pathTransitions[s0][stepClasses[*p0]];
+            s1 = pathTransitions[s1][stepClasses[*p1]];
+            s2 = pathTransitions[s2][stepClasses[*p2]];
+            s3 = pathTransitions[s3][stepClasses[*p3]];
+            p0 += (*p0 != 0);
+            p1 += (*p1 != 0);
+            p2 += (*p2 != 0);
+            p3 += (*p3 != 0);
         }
-        y -= 2;
-        if (g->vertices[y/2][x] == player ||
-            g->vertices[y/2][x] == player+3) {
-            result = TRUE;
+        if (vertexIdsOut != NULL) {
+            vertexIdsOut[i] = pathStateVertex[s0];
+            vertexIdsOut[i+1] = pathStateVertex[s1];
+            vertexIdsOut[i+2] = pathStateVertex[s2];
+            vertexIdsOut[i+3] = pathStateVertex[s3];
         }
-    } else if (xDiff > 0) {
-        y = y/2;
-        x++;
-        if (g->vertices[y][x/2] == player ||
-            g->vertices[y][x/2] == player+3) {
-            result = TRUE;
+        if (arcIdsOut != NULL) {
+            arcIdsOut[i] = pathStateArc[s0];
+            arcIdsOut[i+1] = pathStateArc[s1];
+            arcIdsOut[i+2] = pathStateArc[s2];
+            arcIdsOut[i+3] = pathStateArc[s3];
         }
-        x -= 2;
-        if (g->vertices[y][x/2] == player ||
-            g->vertices[y][x/2] == player+3) {
-            result = TRUE;
+        i += 4;
+    }
+    while (i < n) {
+        int state = decodePathState(paths[i]);
+        if (vertexIdsOut != NULL) {
+            vertexIdsOut[i] = pathStateVertex[state];
         }
+        if (arcIdsOut != NULL) {
+            arcIdsOut[i] = pathStateArc[state];
+        }
+        i++;
     }
-    return result;
 }
 
-static int isCampusAdjacent(Game g, coord vertex) {
-    int x = vertex.x;
-    int y = vertex.y;
-    int result = FALSE;
-    if (y > 0 && y < MAP_VERTEX_HEIGHT) {
-        if (g->vertices[y-1][x] != VACANT_VERTEX ||
-                g->vertices[y+1][x] != VACANT_VERTEX) {
-            result = TRUE;
+static int ownsARCborderingVertex(Game g, int vertexId, int player) {
+    return arcSetsIntersect(g->arcMask[player-1], vertexArcs[vertexId]);
+}
+
+static int ownsARCadjacentTo(Game g, int arcId, int player) {
+    return arcSetsIntersect(g->arcMask[player-1], arcNeighbours[arcId]);
+}
+
+static int ownsVertexBorderingARC(Game g, int arcId, int player) {
+    return (g->campusMask[player-1] & arcEnds[arcId]) != 0;
+}
+
+static int isCampusAdjacent(Game g, int vertexId) {
+    return (occupiedVertices(g) & vertexNeighbours[vertexId]) != 0;
+}
+
+// works out every vertex the current player could build a campus or
+// GO8 on and every ARC they could obtain, from the build frontier.
+// these are the same rules as isLegalActionAt().
+static void findLegalTargets(Game g, uint64_t *campusSites,
+        uint64_t *go8Sites, arcSet *arcSlots) {
+    *campusSites = 0;
+    *go8Sites = 0;
+    arcSlots->lo = 0;
+    arcSlots->hi = 0;
+
+    int player = getWhoseTurn(g);
+    if (getTurnNumber(g) != -1 && UNI_A <= player && player <= UNI_C) {
+        uint16_t *students = g->students[player-1];
+        if (students[STUDENT_BQN] >= 1 && students[STUDENT_BPS] >= 1 &&
+                students[STUDENT_MJ] >= 1 && students[STUDENT_MTV] >= 1) {
+            *campusSites = g->campusFrontier[player-1];
         }
-    }
 
-    if (isValidARC(x*2+1, y*2)) {
-        if (x < MAP_VERTEX_WIDTH) {
-            if (g->vertices[y][x+1] != VACANT_VERTEX) {
-                result = TRUE;
-            }
+        if (g->numGO8s < 8 && students[STUDENT_MJ] >= 2 &&
+                students[STUDENT_MMONEY] >= 3) {
+            *go8Sites = g->campusMask[player-1] & ~g->go8Mask;
         }
-    } else {
-        if (x > 0) {
-            if (g->vertices[y][x-1] != VACANT_VERTEX) {
-                result = TRUE;
-             }
+
+        if (students[STUDENT_BQN] >= 1 && students[STUDENT_BPS] >= 1) {
+            *arcSlots = g->arcFrontier[player-1];
         }
     }
-    return result;
-}
-
-static void updateExchangeRate(Game g, coord vertex, int player) {
-    // special ones are:
-    // 2,1 1,1 - MTV
-    // 3,1 4,1 - MMONEY
-    // 1,8 1,9 - BPS
-    // 4,8 4,9 - MJ
-    // 5,5 5,6 - BQN
-    if (vertex.y == 1 && (vertex.x == 1 || vertex.x == 2)) {
-        g->exchangeRates[player-1][STUDENT_MTV]--;
-    } else if (vertex.y == 1 && (vertex.x == 3 || vertex.x == 4)) {
-        g->exchangeRates[player-1][STUDENT_MMONEY]--;
-    } else if (vertex.x == 1 && (vertex.y == 8 || vertex.y == 9)) {
-        g->exchangeRates[player-1][STUDENT_BPS]--;
-    } else if (vertex.x == 4 && (vertex.y == 8 || vertex.y == 9)) {
-        g->exchangeRates[player-1][STUDENT_MJ]--;
-    } else if (vertex.x == 5 && (vertex.y == 5 || vertex.y == 6)) {
-        g->exchangeRates[player-1][STUDENT_BQN]--;
+}
+
+static int canRetrainFrom(Game g, int player, int discipline) {
+    return getTurnNumber(g) != -1 &&
+            g->students[player-1][discipline] >=
+            g->exchangeRates[player-1][discipline];
+}
+
+static int popCount(uint64_t bits) {
+    return __builtin_popcountll(bits);
+}
+
+// index of the lowest set bit. bits must not be 0
+static int lowestBit(uint64_t bits) {
+    return __builtin_ctzll(bits);
+}
+
+static uint64_t occupiedVertices(Game g) {
+    return g->campusMask[UNI_A-1] | g->campusMask[UNI_B-1] |
+            g->campusMask[UNI_C-1];
+}
+
+static arcSet vacantArcs(Game g) {
+    arcSet vacant;
+    vacant.lo = ~(g->arcMask[UNI_A-1].lo | g->arcMask[UNI_B-1].lo |
+            g->arcMask[UNI_C-1].lo);
+    vacant.hi = ~(g->arcMask[UNI_A-1].hi | g->arcMask[UNI_B-1].hi |
+            g->arcMask[UNI_C-1].hi);
+    return vacant;
+}
+
+// a campus on a retraining centre makes it cheaper to retrain that
+// centre's discipline
+static void updateExchangeRate(Game g, int vertexId, int player) {
+    int discipline = vertexRetrainDiscipline[vertexId];
+    if (discipline != INVALID_ID) {
+        g->exchangeRates[player-1][discipline]--;
     }
 }
 
@@ -0,0 +1,715 @@
+/*
+ * GameBatch.c
+ * Many Knowledge Island games played in lockstep
+ *
+ * Copyright 2015 Simon Shields, Harrison Shoebridge, Julian Tu and James Ye
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <stdint.h>
+#include "Game.h"
+#include "GameExt.h"
+#include "GameBatch.h"
+#include "boardTopology.h"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#define MIN_DICE_VALUE 2
+#define MAX_DICE_VALUE 12
+#define NUM_DICE_VALUES (MAX_DICE_VALUE - MIN_DICE_VALUE + 1)
+
+// games are handled LANES at a time, so every array is padded out to
+// a multiple of LANES games
+#define LANES 8
+#define BATCH_ALIGNMENT 32
+
+// counters per university, and per university per discipline
+#define UNI_ROWS NUM_UNIS
+#define STUDENT_ROWS (NUM_UNIS * NUM_DISCIPLINES)
+
+// the number of rows of 32 bit and 64 bit counters in a batch
+#define INT_ROWS (5 + 2 * STUDENT_ROWS + 6 * UNI_ROWS + \
+        NUM_DICE_VALUES * STUDENT_ROWS + 2 * NUM_REGIONS)
+#define MASK_ROWS (1 + 3 * UNI_ROWS)
+
+// every field is a row of stride values, one per game, so value
+// [row * stride + index] belongs to game index. rows of per player
+// fields are numbered (player-1) or (player-1) * 6 + discipline like
+// the arrays in struct _game
+typedef struct _gameBatch {
+    int numGames;
+    int stride;
+
+    int32_t *turnNumber;
+    int32_t *whoseTurn;
+    int32_t *mostARCgrants;
+    int32_t *mostPublications;
+    int32_t *numGO8s;
+
+    int32_t *students;
+    int32_t *exchangeRates;
+    int32_t *kpi;
+    int32_t *arcGrants;
+    int32_t *campuses;
+    int32_t *groupOfEights;
+    int32_t *patents;
+    int32_t *publications;
+
+    // students gained for each dice value, the same as the production
+    // table in struct _game: row (dice - 2) * 18 + (player-1) * 6 +
+    // discipline
+    int32_t *production;
+
+    int32_t *boardTileDisciplines;
+    int32_t *boardTileDice;
+
+    uint64_t *campusMask;
+    uint64_t *go8Mask;
+    uint64_t *arcMaskLo;
+    uint64_t *arcMaskHi;
+
+    void *block;
+} gameBatch;
+
+// students spent by each action, indexed by discipline then action
+// code. RETRAIN_STUDENTS depends on the exchange rate so it is done
+// separately, and START_SPINOFF costs nothing until it is resolved
+static const int32_t actionCosts[NUM_DISCIPLINES][16] = {
+    // ThD
+    {0},
+    // BPS: campus, ARC
+    {0, 1, 0, 1},
+    // BQN: campus, ARC
+    {0, 1, 0, 1},
+    // MJ: campus, GO8, publication, patent
+    {0, 1, 2, 0, 0, 1, 1},
+    // MTV: campus, publication, patent
+    {0, 1, 0, 0, 0, 1, 1},
+    // M$: GO8, publication, patent
+    {0, 0, 3, 0, 0, 1, 1}
+};
+
+static int32_t *field(GameBatch b, int32_t *rows, int row, int index);
+static uint64_t *maskField(GameBatch b, uint64_t *rows, int row,
+        int index);
+static void throwDiceLane(GameBatch b, int index, int diceScore);
+static void payForMoveLane(GameBatch b, int index, move m);
+static void applyMoveLane(GameBatch b, int index, move m);
+static void addProduction(GameBatch b, int index, int vertexId,
+        int player, int amount);
+static int hasMost(GameBatch b, int32_t *counts, int index, int player);
+
+GameBatch newGameBatch(int numGames) {
+    assert(numGames > 0);
+    gameBatch *b = malloc(sizeof(gameBatch));
+    b->numGames = numGames;
+    b->stride = (numGames + LANES - 1) / LANES * LANES;
+    // the SIMD dice code indexes the production table with 32 bit
+    // offsets
+    assert((int64_t) NUM_DICE_VALUES * STUDENT_ROWS * b->stride <
+            INT32_MAX);
+
+    size_t stride = b->stride;
+    size_t size = MASK_ROWS * stride * sizeof(uint64_t) +
+            INT_ROWS * stride * sizeof(int32_t);
+    int failed = posix_memalign(&b->block, BATCH_ALIGNMENT, size);
+    assert(!failed);
+    memset(b->block, 0, size);
+
+    // the 64 bit rows go first so everything stays aligned
+    uint64_t *masks = b->block;
+    b->campusMask = masks;
+    b->arcMaskLo = b->campusMask + UNI_ROWS * stride;
+    b->arcMaskHi = b->arcMaskLo + UNI_ROWS * stride;
+    b->go8Mask = b->arcMaskHi + UNI_ROWS * stride;
+
+    int32_t *ints = (int32_t *) (b->go8Mask + stride);
+    b->turnNumber = ints;
+    b->whoseTurn = b->turnNumber + stride;
+    b->mostARCgrants = b->whoseTurn + stride;
+    b->mostPublications = b->mostARCgrants + stride;
+    b->numGO8s = b->mostPublications + stride;
+    b->students = b->numGO8s + stride;
+    b->exchangeRates = b->students + STUDENT_ROWS * stride;
+    b->kpi = b->exchangeRates + STUDENT_ROWS * stride;
+    b->arcGrants = b->kpi + UNI_ROWS * stride;
+    b->campuses = b->arcGrants + UNI_ROWS * stride;
+    b->groupOfEights = b->campuses + UNI_ROWS * stride;
+    b->patents = b->groupOfEights + UNI_ROWS * stride;
+    b->publications = b->patents + UNI_ROWS * stride;
+    b->production = b->publications + UNI_ROWS * stride;
+    b->boardTileDisciplines = b->production +
+            NUM_DICE_VALUES * STUDENT_ROWS * stride;
+    b->boardTileDice = b->boardTileDisciplines + NUM_REGIONS * stride;
+    assert(b->boardTileDice + NUM_REGIONS * stride ==
+            ints + INT_ROWS * stride);
+
+    return b;
+}
+
+void disposeGameBatch(GameBatch b) {
+    free(b->block);
+    free(b);
+}
+
+int getBatchSize(GameBatch b) {
+    return b->numGames;
+}
+
+void loadGameIntoBatch(GameBatch b, int index, Game g) {
+    assert(0 <= index && index < b->numGames);
+    int stride = b->stride;
+    b->turnNumber[index] = getTurnNumber(g);
+    b->whoseTurn[index] = getWhoseTurn(g);
+    b->mostARCgrants[index] = getMostARCs(g);
+    b->mostPublications[index] = getMostPublications(g);
+
+    int region = 0;
+    while (region < NUM_REGIONS) {
+        b->boardTileDisciplines[region * stride + index] =
+                getDiscipline(g, region);
+        b->boardTileDice[region * stride + index] =
+                getDiceValue(g, region);
+        region++;
+    }
+
+    b->numGO8s[index] = 0;
+    int player = UNI_A;
+    while (player <= UNI_C) {
+        int row = player - 1;
+        *field(b, b->kpi, row, index) = getKPIpoints(g, player);
+        *field(b, b->arcGrants, row, index) = getARCs(g, player);
+        *field(b, b->campuses, row, index) = getCampuses(g, player);
+        *field(b, b->groupOfEights, row, index) = getGO8s(g, player);
+        *field(b, b->patents, row, index) = getIPs(g, player);
+        *field(b, b->publications, row, index) =
+                getPublications(g, player);
+        *maskField(b, b->campusMask, row, index) = 0;
+        *maskField(b, b->arcMaskLo, row, index) = 0;
+        *maskField(b, b->arcMaskHi, row, index) = 0;
+        b->numGO8s[index] += getGO8s(g, player);
+
+        int discipline = STUDENT_THD;
+        while (discipline <= STUDENT_MMONEY) {
+            row = (player-1) * NUM_DISCIPLINES + discipline;
+            *field(b, b->students, row, index) =
+                    getStudents(g, player, discipline);
+            *field(b, b->exchangeRates, row, index) =
+                    getExchangeRate(g, player, discipline, discipline);
+            discipline++;
+        }
+        player++;
+    }
+
+    int row = 0;
+    while (row < NUM_DICE_VALUES * STUDENT_ROWS) {
+        *field(b, b->production, row, index) = 0;
+        row++;
+    }
+    b->go8Mask[index] = 0;
+    int vertex = 0;
+    while (vertex < NUM_VERTICES) {
+        int contents = getCampusAt(g, vertex);
+        if (contents != VACANT_VERTEX) {
+            // a GO8 is a campus plus an upgrade, and each of those
+            // produces a student
+            int owner = contents;
+            if (owner > CAMPUS_C) {
+                owner -= NUM_UNIS;
+                b->go8Mask[index] |= (uint64_t) 1 << vertex;
+                addProduction(b, index, vertex, owner, 1);
+            }
+            *maskField(b, b->campusMask, owner-1, index) |=
+                    (uint64_t) 1 << vertex;
+            addProduction(b, index, vertex, owner, 1);
+        }
+        vertex++;
+    }
+
+    int arc = 0;
+    while (arc < NUM_ARCS) {
+        int owner = getArcAt(g, arc);
+        if (owner != VACANT_ARC) {
+            if (arc < 64) {
+                *maskField(b, b->arcMaskLo, owner-1, index) |=
+                        (uint64_t) 1 << arc;
+            } else {
+                *maskField(b, b->arcMaskHi, owner-1, index) |=
+                        (uint64_t) 1 << (arc - 64);
+            }
+        }
+        arc++;
+    }
+}
+
+void throwDiceBatch(GameBatch b, const int diceScores[]) {
+    int index = 0;
+#ifdef __AVX2__
+    int stride = b->stride;
+    const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i lastUni = _mm256_set1_epi32(UNI_C);
+    const __m256i seven = _mm256_set1_epi32(7);
+    while (index + LANES <= b->numGames) {
+        __m256i dice = _mm256_loadu_si256(
+                (const __m256i *) &diceScores[index]);
+        __m256i valid = _mm256_and_si256(
+                _mm256_cmpgt_epi32(dice, _mm256_set1_epi32(
+                MIN_DICE_VALUE - 1)),
+                _mm256_cmpgt_epi32(_mm256_set1_epi32(
+                MAX_DICE_VALUE + 1), dice));
+
+        // each game reads the production row for its own dice value.
+        // games with an impossible score are masked out of the gather
+        __m256i offsets = _mm256_add_epi32(_mm256_mullo_epi32(
+                _mm256_sub_epi32(dice, _mm256_set1_epi32(MIN_DICE_VALUE)),
+                _mm256_set1_epi32(STUDENT_ROWS * stride)),
+                _mm256_add_epi32(lanes, _mm256_set1_epi32(index)));
+        int row = 0;
+        while (row < STUDENT_ROWS) {
+            __m256i gain = _mm256_mask_i32gather_epi32(
+                    _mm256_setzero_si256(), (const int *) b->production,
+                    offsets, valid, 4);
+            __m256i *students = (__m256i *) field(b, b->students, row,
+                    index);
+            _mm256_storeu_si256(students, _mm256_add_epi32(
+                    _mm256_loadu_si256(students), gain));
+            offsets = _mm256_add_epi32(offsets, _mm256_set1_epi32(stride));
+            row++;
+        }
+
+        // a 7 turns every MTV and M$ student into a ThD
+        __m256i rolledSeven = _mm256_cmpeq_epi32(dice, seven);
+        int player = UNI_A;
+        while (player <= UNI_C) {
+            int row = (player-1) * NUM_DISCIPLINES;
+            __m256i *thd = (__m256i *) field(b, b->students,
+                    row + STUDENT_THD, index);
+            __m256i *mtv = (__m256i *) field(b, b->students,
+                    row + STUDENT_MTV, index);
+            __m256i *mmoney = (__m256i *) field(b, b->students,
+                    row + STUDENT_MMONEY, index);
+            __m256i lost = _mm256_and_si256(rolledSeven,
+                    _mm256_add_epi32(_mm256_loadu_si256(mtv),
+                    _mm256_loadu_si256(mmoney)));
+            _mm256_storeu_si256(thd, _mm256_add_epi32(
+                    _mm256_loadu_si256(thd), lost));
+            _mm256_storeu_si256(mtv, _mm256_andnot_si256(rolledSeven,
+                    _mm256_loadu_si256(mtv)));
+            _mm256_storeu_si256(mmoney, _mm256_andnot_si256(rolledSeven,
+                    _mm256_loadu_si256(mmoney)));
+            player++;
+        }
+
+        __m256i *turn = (__m256i *) &b->turnNumber[index];
+        _mm256_storeu_si256(turn, _mm256_add_epi32(
+                _mm256_loadu_si256(turn), one));
+        __m256i *whoseTurn = (__m256i *) &b->whoseTurn[index];
+        __m256i next = _mm256_add_epi32(_mm256_loadu_si256(whoseTurn),
+                one);
+        next = _mm256_blendv_epi8(next, one,
+                _mm256_cmpgt_epi32(next, lastUni));
+        _mm256_storeu_si256(whoseTurn, next);
+
+        index += LANES;
+    }
+#endif
+    while (index < b->numGames) {
+        throwDiceLane(b, index, diceScores[index]);
+        index++;
+    }
+}
+
+void makeActionBatch(GameBatch b, const move moves[]) {
+    int index = 0;
+#ifdef __AVX2__
+    const __m256i codeMask = _mm256_set1_epi32(MOVE_CODE_MASK);
+    while (index + LANES <= b->numGames) {
+        // the costs are the same shape for every game, so they are
+        // paid 8 games at a time and only the games whose player it
+        // is are charged
+        __m128i packed = _mm_loadu_si128((const __m128i *) &moves[index]);
+        __m256i codes = _mm256_and_si256(_mm256_cvtepu16_epi32(packed),
+                codeMask);
+        __m256i whoseTurn = _mm256_loadu_si256(
+                (const __m256i *) &b->whoseTurn[index]);
+        int discipline = STUDENT_THD;
+        while (discipline <= STUDENT_MMONEY) {
+            __m256i cost = _mm256_i32gather_epi32(
+                    (const int *) actionCosts[discipline], codes, 4);
+            int player = UNI_A;
+            while (player <= UNI_C) {
+                __m256i isPlayer = _mm256_cmpeq_epi32(whoseTurn,
+                        _mm256_set1_epi32(player));
+                __m256i *students = (__m256i *) field(b, b->students,
+                        (player-1) * NUM_DISCIPLINES + discipline, index);
+                _mm256_storeu_si256(students, _mm256_sub_epi32(
+                        _mm256_loadu_si256(students),
+                        _mm256_and_si256(cost, isPlayer)));
+                player++;
+            }
+            discipline++;
+        }
+
+        // everything else depends on where the move is, which is
+        // different in every game
+        int lane = 0;
+        while (lane < LANES) {
+            applyMoveLane(b, index + lane, moves[index + lane]);
+            lane++;
+        }
+        index += LANES;
+    }
+#endif
+    while (index < b->numGames) {
+        payForMoveLane(b, index, moves[index]);
+        applyMoveLane(b, index, moves[index]);
+        index++;
+    }
+}
+
+// the Game.h getters for a game in the batch
+
+int getBatchTurnNumber(GameBatch b, int index) {
+    return b->turnNumber[index];
+}
+
+int getBatchWhoseTurn(GameBatch b, int index) {
+    return b->whoseTurn[index];
+}
+
+int getBatchMostARCs(GameBatch b, int index) {
+    return b->mostARCgrants[index];
+}
+
+int getBatchMostPublications(GameBatch b, int index) {
+    return b->mostPublications[index];
+}
+
+int getBatchCampusAt(GameBatch b, int index, int vertexId) {
+    int get = VACANT_VERTEX;
+    if (0 <= vertexId && vertexId < NUM_VERTICES) {
+        uint64_t bit = (uint64_t) 1 << vertexId;
+        int uni = UNI_A;
+        while (uni <= UNI_C) {
+            if (*maskField(b, b->campusMask, uni-1, index) & bit) {
+                get = uni;
+                if (b->go8Mask[index] & bit) {
+                    get += NUM_UNIS;
+                }
+            }
+            uni++;
+        }
+    }
+    return get;
+}
+
+int getBatchArcAt(GameBatch b, int index, int arcId) {
+    int get = VACANT_ARC;
+    if (0 <= arcId && arcId < NUM_ARCS) {
+        int uni = UNI_A;
+        while (uni <= UNI_C) {
+            arcSet arcs;
+            arcs.lo = *maskField(b, b->arcMaskLo, uni-1, index);
+            arcs.hi = *maskField(b, b->arcMaskHi, uni-1, index);
+            if (arcSetHas(arcs, arcId)) {
+                get = uni;
+            }
+            uni++;
+        }
+    }
+    return get;
+}
+
+int getBatchKPIpoints(GameBatch b, int index, int player) {
+    int get = 0;
+    if (UNI_A <= player && player <= UNI_C) {
+        get = *field(b, b->kpi, player-1, index);
+    }
+    return get;
+}
+
+int getBatchARCs(GameBatch b, int index, int player) {
+    int get = 0;
+    if (UNI_A <= player && player <= UNI_C) {
+        get = *field(b, b->arcGrants, player-1, index);
+    }
+    return get;
+}
+
+int getBatchGO8s(GameBatch b, int index, int player) {
+    int get = 0;
+    if (UNI_A <= player && player <= UNI_C) {
+        get = *field(b, b->groupOfEights, player-1, index);
+    }
+    return get;
+}
+
+int getBatchCampuses(GameBatch b, int index, int player) {
+    int get = 0;
+    if (UNI_A <= player && player <= UNI_C) {
+        get = *field(b, b->campuses, player-1, index);
+    }
+    return get;
+}
+
+int getBatchIPs(GameBatch b, int index, int player) {
+    int get = 0;
+    if (UNI_A <= player && player <= UNI_C) {
+        get = *field(b, b->patents, player-1, index);
+    }
+    return get;
+}
+
+int getBatchPublications(GameBatch b, int index, int player) {
+    int get = 0;
+    if (UNI_A <= player && player <= UNI_C) {
+        get = *field(b, b->publications, player-1, index);
+    }
+    return get;
+}
+
+int getBatchStudents(GameBatch b, int index, int player,
+        int discipline) {
+    int get = 0;
+    if (UNI_A <= player && player <= UNI_C &&
+            STUDENT_THD <= discipline && discipline <= STUDENT_MMONEY) {
+        get = *field(b, b->students,
+                (player-1) * NUM_DISCIPLINES + discipline, index);
+    }
+    return get;
+}
+
+int getBatchExchangeRate(GameBatch b, int index, int player,
+        int disciplineFrom) {
+    int get = 0;
+    if (UNI_A <= player && player <= UNI_C &&
+            STUDENT_THD <= disciplineFrom &&
+            disciplineFrom <= STUDENT_MMONEY) {
+        get = *field(b, b->exchangeRates,
+                (player-1) * NUM_DISCIPLINES + disciplineFrom, index);
+    }
+    return get;
+}
+
+int batchMatchesGame(GameBatch b, int index, Game g) {
+    int matches = getBatchTurnNumber(b, index) == getTurnNumber(g) &&
+            getBatchWhoseTurn(b, index) == getWhoseTurn(g) &&
+            getBatchMostARCs(b, index) == getMostARCs(g) &&
+            getBatchMostPublications(b, index) == getMostPublications(g);
+
+    int player = UNI_A;
+    while (matches && player <= UNI_C) {
+        matches = getBatchKPIpoints(b, index, player) ==
+                getKPIpoints(g, player) &&
+                getBatchARCs(b, index, player) == getARCs(g, player) &&
+                getBatchGO8s(b, index, player) == getGO8s(g, player) &&
+                getBatchCampuses(b, index, player) ==
+                getCampuses(g, player) &&
+                getBatchIPs(b, index, player) == getIPs(g, player) &&
+                getBatchPublications(b, index, player) ==
+                getPublications(g, player);
+        int discipline = STUDENT_THD;
+        while (matches && discipline <= STUDENT_MMONEY) {
+            matches = getBatchStudents(b, index, player, discipline) ==
+                    getStudents(g, player, discipline) &&
+                    getBatchExchangeRate(b, index, player, discipline) ==
+                    getExchangeRate(g, player, discipline, discipline);
+            discipline++;
+        }
+        player++;
+    }
+
+    int vertex = 0;
+    while (matches && vertex < NUM_VERTICES) {
+        matches = getBatchCampusAt(b, index, vertex) ==
+                getCampusAt(g, vertex);
+        vertex++;
+    }
+    int arc = 0;
+    while (matches && arc < NUM_ARCS) {
+        matches = getBatchArcAt(b, index, arc) == getArcAt(g, arc);
+        arc++;
+    }
+    return matches;
+}
+
+// "private" functions
+
+static int32_t *field(GameBatch b, int32_t *rows, int row, int index) {
+    return &rows[row * b->stride + index];
+}
+
+static uint64_t *maskField(GameBatch b, uint64_t *rows, int row,
+        int index) {
+    return &rows[row * b->stride + index];
+}
+
+// throwDice() for one game, the same steps as the SIMD version
+static void throwDiceLane(GameBatch b, int index, int diceScore) {
+    if (MIN_DICE_VALUE <= diceScore && diceScore <= MAX_DICE_VALUE) {
+        int first = (diceScore - MIN_DICE_VALUE) * STUDENT_ROWS;
+        int row = 0;
+        while (row < STUDENT_ROWS) {
+            *field(b, b->students, row, index) +=
+                    *field(b, b->production, first + row, index);
+            row++;
+        }
+    }
+    if (diceScore == 7) {
+        int player = UNI_A;
+        while (player <= UNI_C) {
+            int row = (player-1) * NUM_DISCIPLINES;
+            int32_t *mtv = field(b, b->students, row + STUDENT_MTV,
+                    index);
+            int32_t *mmoney = field(b, b->students,
+                    row + STUDENT_MMONEY, index);
+            *field(b, b->students, row + STUDENT_THD, index) +=
+                    *mtv + *mmoney;
+            *mtv = 0;
+            *mmoney = 0;
+            player++;
+        }
+    }
+    b->turnNumber[index]++;
+    b->whoseTurn[index]++;
+    if (b->whoseTurn[index] > UNI_C) {
+        b->whoseTurn[index] = UNI_A;
+    }
+}
+
+// takes the fixed student cost of a move off the current player
+static void payForMoveLane(GameBatch b, int index, move m) {
+    int player = b->whoseTurn[index];
+    if (UNI_A <= player && player <= UNI_C) {
+        int discipline = STUDENT_THD;
+        while (discipline <= STUDENT_MMONEY) {
+            *field(b, b->students,
+                    (player-1) * NUM_DISCIPLINES + discipline, index) -=
+                    actionCosts[discipline][MOVE_CODE(m)];
+            discipline++;
+        }
+    }
+}
+
+// everything makeActionAt() does apart from paying the fixed cost
+static void applyMoveLane(GameBatch b, int index, move m) {
+    int player = b->whoseTurn[index];
+    int actionType = MOVE_CODE(m);
+    int target = MOVE_TARGET(m);
+    if (UNI_A <= player && player <= UNI_C) {
+        int row = player - 1;
+        int kpi = 0;
+        if (actionType == BUILD_CAMPUS) {
+            *maskField(b, b->campusMask, row, index) |= (uint64_t) 1 << target;
+            addProduction(b, index, target, player, 1);
+            *field(b, b->campuses, row, index) += 1;
+            int discipline = vertexRetrainDiscipline[target];
+            if (discipline != INVALID_ID) {
+                *field(b, b->exchangeRates,
+                        row * NUM_DISCIPLINES + discipline, index) -= 1;
+            }
+            kpi += 10;
+        } else if (actionType == BUILD_GO8) {
+            b->go8Mask[index] |= (uint64_t) 1 << target;
+            addProduction(b, index, target, player, 1);
+            *field(b, b->groupOfEights, row, index) += 1;
+            *field(b, b->campuses, row, index) -= 1;
+            b->numGO8s[index]++;
+            kpi += 10;
+        } else if (actionType == OBTAIN_ARC) {
+            if (target < 64) {
+                *maskField(b, b->arcMaskLo, row, index) |=
+                        (uint64_t) 1 << target;
+            } else {
+                *maskField(b, b->arcMaskHi, row, index) |=
+                        (uint64_t) 1 << (target - 64);
+            }
+            *field(b, b->arcGrants, row, index) += 1;
+            kpi += 2;
+            // the prestige award moves the same way as updateKPI()
+            int holder = b->mostARCgrants[index];
+            if (hasMost(b, b->arcGrants, index, player) &&
+                    holder != player) {
+                kpi += 10;
+                if (holder != NO_ONE) {
+                    *field(b, b->kpi, holder-1, index) -= 10;
+                }
+                b->mostARCgrants[index] = player;
+            }
+        } else if (actionType == OBTAIN_PUBLICATION) {
+            *field(b, b->publications, row, index) += 1;
+            int holder = b->mostPublications[index];
+            if (hasMost(b, b->publications, index, player) &&
+                    holder != player) {
+                kpi += 10;
+                if (holder != NO_ONE) {
+                    *field(b, b->kpi, holder-1, index) -= 10;
+                }
+                b->mostPublications[index] = player;
+            }
+        } else if (actionType == OBTAIN_IP_PATENT) {
+            *field(b, b->patents, row, index) += 1;
+            kpi += 10;
+        } else if (actionType == RETRAIN_STUDENTS) {
+            int from = row * NUM_DISCIPLINES + MOVE_FROM(m);
+            int to = row * NUM_DISCIPLINES + MOVE_TO(m);
+            *field(b, b->students, from, index) -=
+                    *field(b, b->exchangeRates, from, index);
+            *field(b, b->students, to, index) += 1;
+        }
+        *field(b, b->kpi, row, index) += kpi;
+    }
+}
+
+// updateProduction() for one game in the batch
+static void addProduction(GameBatch b, int index, int vertexId,
+        int player, int amount) {
+    int i = vertexRegionStart[vertexId];
+    while (i < vertexRegionStart[vertexId+1]) {
+        int region = vertexRegionList[i];
+        int diceValue = *field(b, b->boardTileDice, region, index);
+        if (MIN_DICE_VALUE <= diceValue && diceValue <= MAX_DICE_VALUE) {
+            int discipline = *field(b, b->boardTileDisciplines, region,
+                    index);
+            *field(b, b->production,
+                    (diceValue - MIN_DICE_VALUE) * STUDENT_ROWS +
+                    (player-1) * NUM_DISCIPLINES + discipline,
+                    index) += amount;
+        }
+        i++;
+    }
+}
+
+// TRUE if player has strictly more of counts than everyone else
+static int hasMost(GameBatch b, int32_t *counts, int index, int player) {
+    int most = TRUE;
+    int uni = UNI_A;
+    while (uni <= UNI_C) {
+        if (uni != player && *field(b, counts, uni-1, index) >=
+                *field(b, counts, player-1, index)) {
+            most = FALSE;
+        }
+        uni++;
+    }
+    return most;
+}
+
+// vim: sts=4 et cc=72
@@ -0,0 +1,74 @@
+/*
+ * GameBatch.h
+ * Many Knowledge Island games played in lockstep
+ *
+ * Copyright 2015 Simon Shields, Harrison Shoebridge, Julian Tu and James Ye
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * A batch holds N independent games with every field stored as an
+ * array indexed by game (struct of arrays), so throwDiceBatch() and
+ * makeActionBatch() can work on all of them at once. With AVX2 they
+ * do 8 games per instruction, otherwise one at a time. Either way a
+ * game in a batch ends up exactly as the same moves would leave it
+ * through Game.c. Include Game.h and GameExt.h before this file.
+ *
+ */
+
+#ifndef GAME_BATCH_H
+#define GAME_BATCH_H
+
+typedef struct _gameBatch *GameBatch;
+
+// a batch of numGames games, all zeroed. fill each one in with
+// loadGameIntoBatch() before using it
+GameBatch newGameBatch(int numGames);
+void disposeGameBatch(GameBatch b);
+int getBatchSize(GameBatch b);
+
+// copies game g into slot index of the batch
+void loadGameIntoBatch(GameBatch b, int index, Game g);
+
+// throwDice() on every game in the batch. diceScores has one score
+// per game
+void throwDiceBatch(GameBatch b, const int diceScores[]);
+
+// makeAction() on every game in the batch, one move per game. moves
+// must be legal, PASS leaves a game alone, and spinoffs have to be
+// given as OBTAIN_PUBLICATION or OBTAIN_IP_PATENT like makeAction()
+void makeActionBatch(GameBatch b, const move moves[]);
+
+// the Game.h getters for the game in slot index
+int getBatchTurnNumber(GameBatch b, int index);
+int getBatchWhoseTurn(GameBatch b, int index);
+int getBatchMostARCs(GameBatch b, int index);
+int getBatchMostPublications(GameBatch b, int index);
+int getBatchCampusAt(GameBatch b, int index, int vertexId);
+int getBatchArcAt(GameBatch b, int index, int arcId);
+int getBatchKPIpoints(GameBatch b, int index, int player);
+int getBatchARCs(GameBatch b, int index, int player);
+int getBatchGO8s(GameBatch b, int index, int player);
+int getBatchCampuses(GameBatch b, int index, int player);
+int getBatchIPs(GameBatch b, int index, int player);
+int getBatchPublications(GameBatch b, int index, int player);
+int getBatchStudents(GameBatch b, int index, int player,
+                     int discipline);
+int getBatchExchangeRate(GameBatch b, int index, int player,
+                         int disciplineFrom);
+
+// TRUE if the game in slot index is in exactly the same state as g,
+// going by everything the getters can see. for cross checking the
+// batch against Game.c
+int batchMatchesGame(GameBatch b, int index, Game g);
+
+#endif
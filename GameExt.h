@@ -0,0 +1,198 @@
+/*
+ * GameExt.h
+ * Extensions to the Game.h interface for Knowledge Island
+ *
+ * Copyright 2015 Simon Shields, Harrison Shoebridge, Julian Tu and James Ye
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Game.h is fixed by the course, so anything extra we expose lives
+ * here. Include Game.h before this file.
+ *
+ */
+
+#ifndef GAME_EXT_H
+#define GAME_EXT_H
+
+#include <stdint.h>
+
+// every valid vertex and ARC on the island has a dense ID.
+// IDs are handed out row by row (y axis then x axis) over the
+// grids described in Game.c, so vertex 0 is the top campus of A.
+#define NUM_VERTICES 54
+#define NUM_ARCS 72
+#define INVALID_ID -1
+
+#define NUM_DISCIPLINES 6
+
+// a set of ARC IDs. there are more than 64 ARCs so this takes two
+// words, IDs 0..63 in lo and the rest in hi
+typedef struct _arcSet {
+    uint64_t lo;
+    uint64_t hi;
+} arcSet;
+
+// decode a path once and get the ID of the vertex at the end of it,
+// or INVALID_ID if the path is malformed or leaves the island
+int pathToVertexId(path p);
+
+// decode a path once and get the ID of the last ARC traversed, or
+// INVALID_ID if there is no such ARC
+int pathToArcId(path p);
+
+// decodes n paths at once, which is much faster than calling the
+// functions above in a loop. either output array may be NULL if
+// only vertex or only ARC IDs are wanted.
+void decodePaths(path paths[], int n, int vertexIdsOut[],
+                 int arcIdsOut[]);
+
+// a game owns all of its state in one small block with no pointers
+// out of it, so copies are completely independent of the original.
+// cloneGame() returns a new game to be freed with disposeGame(),
+// copyGameInto() overwrites a game that already exists.
+Game cloneGame(Game g);
+void copyGameInto(Game dest, Game src);
+
+// newGame() into a game that already exists, so a game can be used
+// again without allocating
+void resetGame(Game g, int discipline[], int dice[]);
+
+// a 64 bit zobrist hash of the game state: who owns every vertex
+// and ARC, whose turn it is, every student count, patent and
+// publication count, the prestige award holders and the number of
+// GO8s. the turn number is left out so the same position reached on
+// different turns hashes the same. kept up to date incrementally, so
+// this is free to call.
+uint64_t getStateHash(Game g);
+
+// the same hash, but taken with the universities renamed so the one
+// to move is UNI_A, the next one UNI_B and so on. positions that
+// only differ by which seat is which share a canonical hash, so
+// search results can be stored relative to the player to move.
+// whose turn it is drops out. worked out from scratch on each call,
+// which is about as cheap as a handful of moves.
+uint64_t getCanonicalHash(Game g);
+
+// a hash of the disciplines and dice values the board was made with,
+// the same for every game on the same board
+uint64_t getBoardHash(Game g);
+
+// ID based versions of the Game.h getters. an INVALID_ID target
+// behaves like a path that leaves the island.
+int getCampusAt(Game g, int vertexId);
+int getArcAt(Game g, int arcId);
+
+// ID based versions of isLegalAction() and makeAction().
+// target is a vertex ID for BUILD_CAMPUS and BUILD_GO8, an ARC ID for
+// OBTAIN_ARC and ignored otherwise. the disciplines are only used
+// by RETRAIN_STUDENTS.
+int isLegalActionAt(Game g, int actionCode, int target,
+                    int disciplineFrom, int disciplineTo);
+void makeActionAt(Game g, int actionCode, int target,
+                  int disciplineFrom, int disciplineTo);
+
+// everything makeActionWithUndo() or throwDiceWithUndo() changed,
+// which is enough for unmakeAction() or unthrowDice() to put the game
+// back exactly as it was. undo records must be undone in the reverse
+// order they were made.
+#define UNDO_ACTION 0
+#define UNDO_DICE 1
+
+typedef struct _undoRecord {
+    int kind;                  // UNDO_ACTION or UNDO_DICE
+    int actionCode;
+    int target;
+    int player;                // whose turn it was
+    int exchangeDiscipline;    // exchange rate lowered, or INVALID_ID
+    int mostARCgrants;         // prestige holders before the change
+    int mostPublications;
+    uint64_t hash;             // state hash before the change
+    uint64_t campusFrontier[NUM_UNIS];  // build frontiers before it
+    arcSet arcFrontier[NUM_UNIS];
+    short studentDeltas[NUM_UNIS][NUM_DISCIPLINES];
+    short kpiDeltas[NUM_UNIS];
+} undoRecord;
+
+// makeActionAt() and throwDice() that also fill in an undo record
+void makeActionWithUndo(Game g, int actionCode, int target,
+                        int disciplineFrom, int disciplineTo,
+                        undoRecord *undo);
+void throwDiceWithUndo(Game g, int diceScore, undoRecord *undo);
+
+// undo the change recorded in undo, which must be the last change
+// still applied to the game
+void unmakeAction(Game g, const undoRecord *undo);
+void unthrowDice(Game g, const undoRecord *undo);
+
+// a move is an action packed into 16 bits: the action code in the
+// low 4 bits and an operand above it. the operand is the vertex or
+// ARC ID the action operates on, or for RETRAIN_STUDENTS the from
+// discipline times 8 plus the to discipline.
+typedef unsigned short move;
+
+#define MOVE_CODE_BITS 4
+#define MOVE_CODE_MASK 0xF
+#define ENCODE_MOVE(actionCode, target) \
+        ((move) ((actionCode) | ((target) << MOVE_CODE_BITS)))
+#define ENCODE_RETRAIN(from, to) \
+        ENCODE_MOVE(RETRAIN_STUDENTS, (from) * 8 + (to))
+#define MOVE_CODE(m) ((m) & MOVE_CODE_MASK)
+#define MOVE_TARGET(m) ((m) >> MOVE_CODE_BITS)
+#define MOVE_FROM(m) (MOVE_TARGET(m) / 8)
+#define MOVE_TO(m) (MOVE_TARGET(m) % 8)
+
+// the operand of a move whose destination is not on the island
+#define MOVE_NO_TARGET 0xFFF
+
+// converts between moves and actions. an action's destination is
+// decoded once, and a move's is turned back into a shortest path to
+// the same vertex or ARC, so the path may differ from the one the
+// move was made from. destinations off the island stay off it.
+move actionToMove(action a);
+action moveToAction(move m);
+
+// isLegalAction() and makeAction() for a move
+int isLegalMove(Game g, move m);
+void makeMove(Game g, move m);
+
+// makeActionWithUndo() for a move, undone with unmakeAction()
+void makeMoveWithUndo(Game g, move m, undoRecord *undo);
+
+// the most moves generateLegalActions() can ever find: every vertex
+// twice (campus or GO8), every ARC, a spinoff and 5 * 6 retrainings
+#define MAX_LEGAL_MOVES (NUM_VERTICES * 2 + NUM_ARCS + 1 + 5 * 6)
+
+// fills buffer with every legal BUILD_CAMPUS, BUILD_GO8, OBTAIN_ARC,
+// START_SPINOFF and RETRAIN_STUDENTS move for the current player (PASS
+// is always legal and is left out). at most cap moves are written but
+// the full number of legal moves is returned, so a buffer of
+// MAX_LEGAL_MOVES is always big enough.
+int generateLegalActions(Game g, move buffer[], int cap);
+
+// the number of moves generateLegalActions() would return, without
+// listing them
+int countLegalActions(Game g);
+
+// the build frontier of each university: every vacant vertex that
+// touches one of its ARCs and has no campus next to it, and every
+// vacant ARC next to one of its ARCs or campuses. these are where it
+// could build if it had the students. kept up to date as the game
+// changes, so the masks are free to get. the list versions write the
+// IDs lowest first and return how many there are; the buffers need
+// room for NUM_VERTICES or NUM_ARCS IDs.
+uint64_t getCampusFrontier(Game g, int player);
+arcSet getArcFrontier(Game g, int player);
+int listCampusFrontier(Game g, int player, int vertexIdsOut[]);
+int listArcFrontier(Game g, int player, int arcIdsOut[]);
+
+#endif
@@ -0,0 +1,183 @@
+/*
+ * boardAnalysis.c
+ * What each vertex of a Knowledge Island board is worth
+ *
+ * Copyright 2015 Simon Shields, Harrison Shoebridge, Julian Tu and James Ye
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <stdlib.h>
+#include <assert.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "Game.h"
+#include "GameExt.h"
+#include "boardTopology.h"
+#include "boardAnalysis.h"
+
+#define MIN_DICE_VALUE 2
+#define MAX_DICE_VALUE 12
+
+// retraining at a centre costs 2 students instead of 3, so each
+// student of its discipline is worth a sixth of a student more. the
+// owner is counted as getting a university's share of what the
+// board produces of it
+#define RETRAIN_SAVING (1.0f / 2 - 1.0f / 3)
+
+// boards kept at once, a power of two. each board has one place it
+// can go, picked by its hash
+#define CACHE_SIZE 64
+
+typedef struct _boardInfo {
+    uint64_t hash;
+    uint8_t disciplines[NUM_REGIONS];
+    uint8_t dice[NUM_REGIONS];
+    float disciplineYield[NUM_VERTICES][NUM_DISCIPLINES];
+    float yield[NUM_VERTICES];
+    float value[NUM_VERTICES];
+    float boardYield[NUM_DISCIPLINES];
+    int refs;          // getBoardInfo() calls not yet released
+    int cached;        // FALSE if freed when refs gets back to 0
+} boardInfo;
+
+// a board and the lock for its place in the cache, which also guards
+// refs of every board that hashes there
+typedef struct _cacheSlot {
+    pthread_mutex_t lock;
+    boardInfo *b;
+} cacheSlot;
+
+static cacheSlot cache[CACHE_SIZE];
+static pthread_once_t cacheOnce = PTHREAD_ONCE_INIT;
+
+static void initCache(void);
+static int isSameBoard(const boardInfo *b, Game g);
+static boardInfo *buildBoard(Game g, uint64_t hash);
+
+BoardInfo getBoardInfo(Game g) {
+    pthread_once(&cacheOnce, initCache);
+    uint64_t hash = getBoardHash(g);
+    cacheSlot *slot = &cache[hash & (CACHE_SIZE - 1)];
+    pthread_mutex_lock(&slot->lock);
+    boardInfo *b = slot->b;
+    if (b == NULL || b->hash != hash || !isSameBoard(b, g)) {
+        // the board there makes way unless someone is still using
+        // it, in which case this one is only lent out
+        b = buildBoard(g, hash);
+        if (slot->b == NULL || slot->b->refs == 0) {
+            free(slot->b);
+            slot->b = b;
+            b->cached = TRUE;
+        }
+    }
+    b->refs++;
+    pthread_mutex_unlock(&slot->lock);
+    return b;
+}
+
+void releaseBoardInfo(BoardInfo info) {
+    boardInfo *b = (boardInfo *) info;
+    cacheSlot *slot = &cache[b->hash & (CACHE_SIZE - 1)];
+    pthread_mutex_lock(&slot->lock);
+    b->refs--;
+    int unused = !b->cached && b->refs == 0;
+    pthread_mutex_unlock(&slot->lock);
+    if (unused) {
+        free(b);
+    }
+}
+
+float getVertexDisciplineYield(BoardInfo b, int vertexId,
+                               int discipline) {
+    return b->disciplineYield[vertexId][discipline];
+}
+
+float getVertexYield(BoardInfo b, int vertexId) {
+    return b->yield[vertexId];
+}
+
+float getVertexValue(BoardInfo b, int vertexId) {
+    return b->value[vertexId];
+}
+
+float getBoardDisciplineYield(BoardInfo b, int discipline) {
+    return b->boardYield[discipline];
+}
+
+static void initCache(void) {
+    int i = 0;
+    while (i < CACHE_SIZE) {
+        pthread_mutex_init(&cache[i].lock, NULL);
+        cache[i].b = NULL;
+        i++;
+    }
+}
+
+static int isSameBoard(const boardInfo *b, Game g) {
+    int same = TRUE;
+    int region = 0;
+    while (same && region < NUM_REGIONS) {
+        same = b->disciplines[region] == getDiscipline(g, region) &&
+                b->dice[region] == getDiceValue(g, region);
+        region++;
+    }
+    return same;
+}
+
+static boardInfo *buildBoard(Game g, uint64_t hash) {
+    boardInfo *b = calloc(1, sizeof(boardInfo));
+    assert(b != NULL);
+    b->hash = hash;
+    float regionYield[NUM_REGIONS];
+    int region = 0;
+    while (region < NUM_REGIONS) {
+        int discipline = getDiscipline(g, region);
+        int dice = getDiceValue(g, region);
+        b->disciplines[region] = discipline;
+        b->dice[region] = dice;
+        regionYield[region] = 0;
+        if (MIN_DICE_VALUE <= dice && dice <= MAX_DICE_VALUE) {
+            int ways = 6 - abs(7 - dice);
+            regionYield[region] = ways / 36.0f;
+        }
+        b->boardYield[discipline] += regionYield[region];
+        region++;
+    }
+
+    int vertex = 0;
+    while (vertex < NUM_VERTICES) {
+        int i = vertexRegionStart[vertex];
+        while (i < vertexRegionStart[vertex + 1]) {
+            region = vertexRegionList[i];
+            int discipline = b->disciplines[region];
+            b->disciplineYield[vertex][discipline] +=
+                    regionYield[region];
+            if (discipline != STUDENT_THD) {
+                b->yield[vertex] += regionYield[region];
+            }
+            i++;
+        }
+        b->value[vertex] = b->yield[vertex];
+        int retrain = vertexRetrainDiscipline[vertex];
+        if (retrain != INVALID_ID) {
+            b->value[vertex] += RETRAIN_SAVING *
+                    b->boardYield[retrain] / NUM_UNIS;
+        }
+        vertex++;
+    }
+    return b;
+}
+
+// vim: sts=4 et cc=72
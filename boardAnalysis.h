@@ -0,0 +1,60 @@
+/*
+ * boardAnalysis.h
+ * What each vertex of a Knowledge Island board is worth
+ *
+ * Copyright 2015 Simon Shields, Harrison Shoebridge, Julian Tu and James Ye
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * The students a campus can expect only depend on the board, so they
+ * are worked out once per board layout, the first time a game on it
+ * asks, and kept in a fixed size cache under getBoardHash(). The
+ * tables are never changed once built, so any number of games and
+ * threads can read them at once. Look the board up once per decision
+ * with getBoardInfo(), release it when the decision is made, and the
+ * queries in between are array reads. A board is only dropped from
+ * the cache once it is released and another board needs its place.
+ * Include Game.h and GameExt.h before this file.
+ *
+ */
+
+#ifndef BOARD_ANALYSIS_H
+#define BOARD_ANALYSIS_H
+
+typedef const struct _boardInfo *BoardInfo;
+
+// the tables for the board g is played on, built if they aren't
+// cached. each call needs a releaseBoardInfo() when done with them
+BoardInfo getBoardInfo(Game g);
+
+// done with tables from getBoardInfo(), which mustn't be used after
+void releaseBoardInfo(BoardInfo b);
+
+// the students of a discipline a campus on vertexId can expect per
+// dice roll
+float getVertexDisciplineYield(BoardInfo b, int vertexId,
+                               int discipline);
+
+// the students a campus on vertexId can expect per dice roll, leaving
+// out THD which can't be built with
+float getVertexYield(BoardInfo b, int vertexId);
+
+// getVertexYield() plus what the retraining centre on vertexId, if
+// there is one, is worth in students per roll
+float getVertexValue(BoardInfo b, int vertexId);
+
+// the students of a discipline the whole board produces per roll,
+// counting each region once
+float getBoardDisciplineYield(BoardInfo b, int discipline);
+
+#endif
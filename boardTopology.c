@@ -0,0 +1,37 @@
+/*
+ * boardTopology.c
+ * The shape of the Knowledge Island board: which vertices, ARCs and
+ * regions exist and what touches what
+ *
+ * Copyright 2015 Simon Shields, Harrison Shoebridge, Julian Tu and James Ye
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <stdint.h>
+#include "Game.h"
+#include "GameExt.h"
+#include "boardTopology.h"
+
+#include "boardTopologyTables.h"
+
+int vertexIdAt(int x, int y) {
+    int id = INVALID_ID;
+    if (x >= 0 && x < MAP_VERTEX_WIDTH && y >= 0 && y < MAP_VERTEX_HEIGHT) {
+        id = vertexIds[y][x];
+    }
+    return id;
+}
+
+// vim: sts=4 et cc=72
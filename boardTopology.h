@@ -0,0 +1,153 @@
+/*
+ * boardTopology.h
+ * The shape of the Knowledge Island board: which vertices, ARCs and
+ * regions exist and what touches what
+ *
+ * Copyright 2015 Simon Shields, Harrison Shoebridge, Julian Tu and James Ye
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Include Game.h and GameExt.h before this file.
+ *
+ */
+
+#ifndef BOARD_TOPOLOGY_H
+#define BOARD_TOPOLOGY_H
+
+#include <stdint.h>
+
+// the board is laid out on three grids (y axis then x axis), see the
+// picture in Game.c. ARC coordinates are the sum of the coordinates
+// of the two vertices at either end.
+#define MAP_ARC_HEIGHT 21
+#define MAP_ARC_WIDTH 11
+#define MAP_VERTEX_HEIGHT 11
+#define MAP_VERTEX_WIDTH 6
+#define MAP_REGION_HEIGHT 9
+#define MAP_REGION_WIDTH 5
+
+#define MAX_VERTEX_REGIONS 3
+
+typedef struct _coord {
+    int x;
+    int y;
+} coord;
+
+// the path decoder is a table driven state machine. a state is a
+// vertex plus the heading of the step that reached it, which is all
+// that is needed to work out where the next L, R or B goes.
+#define HEADING_UP 0
+#define HEADING_DOWN 1
+#define HEADING_LEFT 2
+#define HEADING_RIGHT 3
+#define NUM_HEADINGS 4
+#define PATH_STATE_START (NUM_VERTICES * NUM_HEADINGS)
+#define PATH_STATE_DEAD (PATH_STATE_START + 1)
+#define NUM_PATH_STATES (PATH_STATE_DEAD + 1)
+
+#define STEP_L 0
+#define STEP_R 1
+#define STEP_B 2
+#define STEP_INVALID 3
+#define STEP_END 4
+#define NUM_STEP_CLASSES 5
+
+// the tables are generated by tools/genTopology.c into
+// boardTopologyTables.h, so they are ready before the game starts
+#ifndef GENERATING_TOPOLOGY
+
+// dense IDs for the valid cells of the vertex and ARC grids, and the
+// cell each ID came from. invalid cells hold INVALID_ID
+extern const int vertexIds[MAP_VERTEX_HEIGHT][MAP_VERTEX_WIDTH];
+extern const int arcIds[MAP_ARC_HEIGHT][MAP_ARC_WIDTH];
+extern const coord vertexCoords[NUM_VERTICES];
+extern const coord arcCoords[NUM_ARCS];
+
+// region IDs (the index into the newGame arrays) of the valid region
+// grid cells
+extern const int regionIds[MAP_REGION_HEIGHT][MAP_REGION_WIDTH];
+
+// what touches each vertex and ARC, as masks over IDs
+extern const uint64_t vertexNeighbours[NUM_VERTICES];
+extern const arcSet vertexArcs[NUM_VERTICES];
+extern const arcSet arcNeighbours[NUM_ARCS];
+extern const uint64_t arcEnds[NUM_ARCS];
+
+// the same adjacencies as lists, plus which regions touch which
+// vertices. the IDs next to item i are xList[xStart[i]] up to but not
+// including xList[xStart[i+1]], lowest ID first
+extern const int vertexNeighbourStart[NUM_VERTICES + 1];
+extern const int vertexNeighbourList[];
+extern const int vertexArcStart[NUM_VERTICES + 1];
+extern const int vertexArcList[];
+extern const int arcNeighbourStart[NUM_ARCS + 1];
+extern const int arcNeighbourList[];
+extern const int arcEndStart[NUM_ARCS + 1];
+extern const int arcEndList[];
+extern const int vertexRegionStart[NUM_VERTICES + 1];
+extern const int vertexRegionList[];
+extern const int regionVertexStart[NUM_REGIONS + 1];
+extern const int regionVertexList[];
+
+// the discipline a campus on each vertex gets cheaper retraining
+// for, or INVALID_ID if the vertex is not on a retraining centre
+extern const int vertexRetrainDiscipline[NUM_VERTICES];
+
+// the path decoder: the step class of every character, the state
+// each step leads to, and the vertex and last ARC of each state
+extern const signed char stepClasses[256];
+extern const short pathTransitions[NUM_PATH_STATES][NUM_STEP_CLASSES];
+extern const short pathStateVertex[NUM_PATH_STATES];
+extern const short pathStateArc[NUM_PATH_STATES];
+
+// a shortest path from the top campus of A to each vertex, and one
+// whose last step crosses each ARC
+extern const char *const vertexPaths[NUM_VERTICES];
+extern const char *const arcPaths[NUM_ARCS];
+
+// the ID of the vertex at (x, y), or INVALID_ID if there isn't one
+int vertexIdAt(int x, int y);
+
+#endif
+
+static inline int arcSetHas(arcSet set, int arcId) {
+    int has;
+    if (arcId < 64) {
+        has = (set.lo >> arcId) & 1;
+    } else {
+        has = (set.hi >> (arcId - 64)) & 1;
+    }
+    return has;
+}
+
+static inline int arcSetsIntersect(arcSet a, arcSet b) {
+    return ((a.lo & b.lo) | (a.hi & b.hi)) != 0;
+}
+
+static inline void arcSetAdd(arcSet *set, int arcId) {
+    if (arcId < 64) {
+        set->lo |= (uint64_t) 1 << arcId;
+    } else {
+        set->hi |= (uint64_t) 1 << (arcId - 64);
+    }
+}
+
+static inline void arcSetRemove(arcSet *set, int arcId) {
+    if (arcId < 64) {
+        set->lo &= ~((uint64_t) 1 << arcId);
+    } else {
+        set->hi &= ~((uint64_t) 1 << (arcId - 64));
+    }
+}
+
+#endif
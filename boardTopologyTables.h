@@ -0,0 +1,924 @@
+/*
+ * boardTopologyTables.h
+ * Generated by tools/genTopology.c, do not edit.
+ *
+ * Only boardTopology.c includes this file. Everything in it
+ * is declared in boardTopology.h.
+ *
+ */
+
+const int vertexIds[MAP_VERTEX_HEIGHT][MAP_VERTEX_WIDTH] = {
+    {-1, -1, 0, 1, -1, -1},
+    {-1, 2, 3, 4, 5, -1},
+    {6, 7, 8, 9, 10, 11},
+    {12, 13, 14, 15, 16, 17},
+    {18, 19, 20, 21, 22, 23},
+    {24, 25, 26, 27, 28, 29},
+    {30, 31, 32, 33, 34, 35},
+    {36, 37, 38, 39, 40, 41},
+    {42, 43, 44, 45, 46, 47},
+    {-1, 48, 49, 50, 51, -1},
+    {-1, -1, 52, 53, -1, -1}
+};
+
+const int arcIds[MAP_ARC_HEIGHT][MAP_ARC_WIDTH] = {
+    {-1, -1, -1, -1, -1, 0, -1, -1, -1, -1, -1},
+    {-1, -1, -1, -1, 1, -1, 2, -1, -1, -1, -1},
+    {-1, -1, -1, 3, -1, -1, -1, 4, -1, -1, -1},
+    {-1, -1, 5, -1, 6, -1, 7, -1, 8, -1, -1},
+    {-1, 9, -1, -1, -1, 10, -1, -1, -1, 11, -1},
+    {12, -1, 13, -1, 14, -1, 15, -1, 16, -1, 17},
+    {-1, -1, -1, 18, -1, -1, -1, 19, -1, -1, -1},
+    {20, -1, 21, -1, 22, -1, 23, -1, 24, -1, 25},
+    {-1, 26, -1, -1, -1, 27, -1, -1, -1, 28, -1},
+    {29, -1, 30, -1, 31, -1, 32, -1, 33, -1, 34},
+    {-1, -1, -1, 35, -1, -1, -1, 36, -1, -1, -1},
+    {37, -1, 38, -1, 39, -1, 40, -1, 41, -1, 42},
+    {-1, 43, -1, -1, -1, 44, -1, -1, -1, 45, -1},
+    {46, -1, 47, -1, 48, -1, 49, -1, 50, -1, 51},
+    {-1, -1, -1, 52, -1, -1, -1, 53, -1, -1, -1},
+    {54, -1, 55, -1, 56, -1, 57, -1, 58, -1, 59},
+    {-1, 60, -1, -1, -1, 61, -1, -1, -1, 62, -1},
+    {-1, -1, 63, -1, 64, -1, 65, -1, 66, -1, -1},
+    {-1, -1, -1, 67, -1, -1, -1, 68, -1, -1, -1},
+    {-1, -1, -1, -1, 69, -1, 70, -1, -1, -1, -1},
+    {-1, -1, -1, -1, -1, 71, -1, -1, -1, -1, -1}
+};
+
+const coord vertexCoords[NUM_VERTICES] = {
+    {2, 0}, {3, 0}, {1, 1}, {2, 1}, {3, 1}, {4, 1},
+    {0, 2}, {1, 2}, {2, 2}, {3, 2}, {4, 2}, {5, 2},
+    {0, 3}, {1, 3}, {2, 3}, {3, 3}, {4, 3}, {5, 3},
+    {0, 4}, {1, 4}, {2, 4}, {3, 4}, {4, 4}, {5, 4},
+    {0, 5}, {1, 5}, {2, 5}, {3, 5}, {4, 5}, {5, 5},
+    {0, 6}, {1, 6}, {2, 6}, {3, 6}, {4, 6}, {5, 6},
+    {0, 7}, {1, 7}, {2, 7}, {3, 7}, {4, 7}, {5, 7},
+    {0, 8}, {1, 8}, {2, 8}, {3, 8}, {4, 8}, {5, 8},
+    {1, 9}, {2, 9}, {3, 9}, {4, 9}, {2, 10}, {3, 10}
+};
+
+const coord arcCoords[NUM_ARCS] = {
+    {5, 0}, {4, 1}, {6, 1}, {3, 2}, {7, 2}, {2, 3},
+    {4, 3}, {6, 3}, {8, 3}, {1, 4}, {5, 4}, {9, 4},
+    {0, 5}, {2, 5}, {4, 5}, {6, 5}, {8, 5}, {10, 5},
+    {3, 6}, {7, 6}, {0, 7}, {2, 7}, {4, 7}, {6, 7},
+    {8, 7}, {10, 7}, {1, 8}, {5, 8}, {9, 8}, {0, 9},
+    {2, 9}, {4, 9}, {6, 9}, {8, 9}, {10, 9}, {3, 10},
+    {7, 10}, {0, 11}, {2, 11}, {4, 11}, {6, 11}, {8, 11},
+    {10, 11}, {1, 12}, {5, 12}, {9, 12}, {0, 13}, {2, 13},
+    {4, 13}, {6, 13}, {8, 13}, {10, 13}, {3, 14}, {7, 14},
+    {0, 15}, {2, 15}, {4, 15}, {6, 15}, {8, 15}, {10, 15},
+    {1, 16}, {5, 16}, {9, 16}, {2, 17}, {4, 17}, {6, 17},
+    {8, 17}, {3, 18}, {7, 18}, {4, 19}, {6, 19}, {5, 20}
+};
+
+const int regionIds[MAP_REGION_HEIGHT][MAP_REGION_WIDTH] = {
+    {-1, -1, 7, -1, -1},
+    {-1, 3, -1, 12, -1},
+    {0, -1, 8, -1, 16},
+    {-1, 4, -1, 13, -1},
+    {1, -1, 9, -1, 17},
+    {-1, 5, -1, 14, -1},
+    {2, -1, 10, -1, 18},
+    {-1, 6, -1, 15, -1},
+    {-1, -1, 11, -1, -1}
+};
+
+const uint64_t vertexNeighbours[NUM_VERTICES] = {
+    0x000000000000000aULL,
+    0x0000000000000011ULL,
+    0x0000000000000088ULL,
+    0x0000000000000105ULL,
+    0x0000000000000222ULL,
+    0x0000000000000410ULL,
+    0x0000000000001080ULL,
+    0x0000000000002044ULL,
+    0x0000000000004208ULL,
+    0x0000000000008110ULL,
+    0x0000000000010820ULL,
+    0x0000000000020400ULL,
+    0x0000000000040040ULL,
+    0x0000000000084080ULL,
+    0x0000000000102100ULL,
+    0x0000000000210200ULL,
+    0x0000000000408400ULL,
+    0x0000000000800800ULL,
+    0x0000000001081000ULL,
+    0x0000000002042000ULL,
+    0x0000000004204000ULL,
+    0x0000000008108000ULL,
+    0x0000000010810000ULL,
+    0x0000000020420000ULL,
+    0x0000000040040000ULL,
+    0x0000000084080000ULL,
+    0x0000000102100000ULL,
+    0x0000000210200000ULL,
+    0x0000000408400000ULL,
+    0x0000000800800000ULL,
+    0x0000001081000000ULL,
+    0x0000002042000000ULL,
+    0x0000004204000000ULL,
+    0x0000008108000000ULL,
+    0x0000010810000000ULL,
+    0x0000020420000000ULL,
+    0x0000040040000000ULL,
+    0x0000084080000000ULL,
+    0x0000102100000000ULL,
+    0x0000210200000000ULL,
+    0x0000408400000000ULL,
+    0x0000800800000000ULL,
+    0x0000081000000000ULL,
+    0x0001042000000000ULL,
+    0x0002204000000000ULL,
+    0x0004108000000000ULL,
+    0x0008810000000000ULL,
+    0x0000420000000000ULL,
+    0x0002080000000000ULL,
+    0x0011100000000000ULL,
+    0x0028200000000000ULL,
+    0x0004400000000000ULL,
+    0x0022000000000000ULL,
+    0x0014000000000000ULL
+};
+
+const arcSet vertexArcs[NUM_VERTICES] = {
+    {0x0000000000000003ULL, 0x0000000000000000ULL},
+    {0x0000000000000005ULL, 0x0000000000000000ULL},
+    {0x0000000000000028ULL, 0x0000000000000000ULL},
+    {0x000000000000004aULL, 0x0000000000000000ULL},
+    {0x0000000000000094ULL, 0x0000000000000000ULL},
+    {0x0000000000000110ULL, 0x0000000000000000ULL},
+    {0x0000000000001200ULL, 0x0000000000000000ULL},
+    {0x0000000000002220ULL, 0x0000000000000000ULL},
+    {0x0000000000004440ULL, 0x0000000000000000ULL},
+    {0x0000000000008480ULL, 0x0000000000000000ULL},
+    {0x0000000000010900ULL, 0x0000000000000000ULL},
+    {0x0000000000020800ULL, 0x0000000000000000ULL},
+    {0x0000000000101000ULL, 0x0000000000000000ULL},
+    {0x0000000000242000ULL, 0x0000000000000000ULL},
+    {0x0000000000444000ULL, 0x0000000000000000ULL},
+    {0x0000000000888000ULL, 0x0000000000000000ULL},
+    {0x0000000001090000ULL, 0x0000000000000000ULL},
+    {0x0000000002020000ULL, 0x0000000000000000ULL},
+    {0x0000000024100000ULL, 0x0000000000000000ULL},
+    {0x0000000044200000ULL, 0x0000000000000000ULL},
+    {0x0000000088400000ULL, 0x0000000000000000ULL},
+    {0x0000000108800000ULL, 0x0000000000000000ULL},
+    {0x0000000211000000ULL, 0x0000000000000000ULL},
+    {0x0000000412000000ULL, 0x0000000000000000ULL},
+    {0x0000002020000000ULL, 0x0000000000000000ULL},
+    {0x0000004840000000ULL, 0x0000000000000000ULL},
+    {0x0000008880000000ULL, 0x0000000000000000ULL},
+    {0x0000011100000000ULL, 0x0000000000000000ULL},
+    {0x0000021200000000ULL, 0x0000000000000000ULL},
+    {0x0000040400000000ULL, 0x0000000000000000ULL},
+    {0x0000482000000000ULL, 0x0000000000000000ULL},
+    {0x0000884000000000ULL, 0x0000000000000000ULL},
+    {0x0001108000000000ULL, 0x0000000000000000ULL},
+    {0x0002110000000000ULL, 0x0000000000000000ULL},
+    {0x0004220000000000ULL, 0x0000000000000000ULL},
+    {0x0008240000000000ULL, 0x0000000000000000ULL},
+    {0x0040400000000000ULL, 0x0000000000000000ULL},
+    {0x0090800000000000ULL, 0x0000000000000000ULL},
+    {0x0111000000000000ULL, 0x0000000000000000ULL},
+    {0x0222000000000000ULL, 0x0000000000000000ULL},
+    {0x0424000000000000ULL, 0x0000000000000000ULL},
+    {0x0808000000000000ULL, 0x0000000000000000ULL},
+    {0x1040000000000000ULL, 0x0000000000000000ULL},
+    {0x9080000000000000ULL, 0x0000000000000000ULL},
+    {0x2100000000000000ULL, 0x0000000000000001ULL},
+    {0x2200000000000000ULL, 0x0000000000000002ULL},
+    {0x4400000000000000ULL, 0x0000000000000004ULL},
+    {0x4800000000000000ULL, 0x0000000000000000ULL},
+    {0x8000000000000000ULL, 0x0000000000000008ULL},
+    {0x0000000000000000ULL, 0x0000000000000029ULL},
+    {0x0000000000000000ULL, 0x0000000000000052ULL},
+    {0x0000000000000000ULL, 0x0000000000000014ULL},
+    {0x0000000000000000ULL, 0x00000000000000a0ULL},
+    {0x0000000000000000ULL, 0x00000000000000c0ULL}
+};
+
+const arcSet arcNeighbours[NUM_ARCS] = {
+    {0x0000000000000006ULL, 0x0000000000000000ULL},
+    {0x0000000000000049ULL, 0x0000000000000000ULL},
+    {0x0000000000000091ULL, 0x0000000000000000ULL},
+    {0x0000000000000062ULL, 0x0000000000000000ULL},
+    {0x0000000000000184ULL, 0x0000000000000000ULL},
+    {0x0000000000002208ULL, 0x0000000000000000ULL},
+    {0x000000000000440aULL, 0x0000000000000000ULL},
+    {0x0000000000008414ULL, 0x0000000000000000ULL},
+    {0x0000000000010810ULL, 0x0000000000000000ULL},
+    {0x0000000000003020ULL, 0x0000000000000000ULL},
+    {0x000000000000c0c0ULL, 0x0000000000000000ULL},
+    {0x0000000000030100ULL, 0x0000000000000000ULL},
+    {0x0000000000100200ULL, 0x0000000000000000ULL},
+    {0x0000000000240220ULL, 0x0000000000000000ULL},
+    {0x0000000000440440ULL, 0x0000000000000000ULL},
+    {0x0000000000880480ULL, 0x0000000000000000ULL},
+    {0x0000000001080900ULL, 0x0000000000000000ULL},
+    {0x0000000002000800ULL, 0x0000000000000000ULL},
+    {0x0000000000606000ULL, 0x0000000000000000ULL},
+    {0x0000000001818000ULL, 0x0000000000000000ULL},
+    {0x0000000024001000ULL, 0x0000000000000000ULL},
+    {0x0000000044042000ULL, 0x0000000000000000ULL},
+    {0x0000000088044000ULL, 0x0000000000000000ULL},
+    {0x0000000108088000ULL, 0x0000000000000000ULL},
+    {0x0000000210090000ULL, 0x0000000000000000ULL},
+    {0x0000000410020000ULL, 0x0000000000000000ULL},
+    {0x0000000060300000ULL, 0x0000000000000000ULL},
+    {0x0000000180c00000ULL, 0x0000000000000000ULL},
+    {0x0000000603000000ULL, 0x0000000000000000ULL},
+    {0x0000002004100000ULL, 0x0000000000000000ULL},
+    {0x0000004804200000ULL, 0x0000000000000000ULL},
+    {0x0000008808400000ULL, 0x0000000000000000ULL},
+    {0x0000011008800000ULL, 0x0000000000000000ULL},
+    {0x0000021011000000ULL, 0x0000000000000000ULL},
+    {0x0000040012000000ULL, 0x0000000000000000ULL},
+    {0x000000c0c0000000ULL, 0x0000000000000000ULL},
+    {0x0000030300000000ULL, 0x0000000000000000ULL},
+    {0x0000480020000000ULL, 0x0000000000000000ULL},
+    {0x0000880840000000ULL, 0x0000000000000000ULL},
+    {0x0001100880000000ULL, 0x0000000000000000ULL},
+    {0x0002101100000000ULL, 0x0000000000000000ULL},
+    {0x0004201200000000ULL, 0x0000000000000000ULL},
+    {0x0008200400000000ULL, 0x0000000000000000ULL},
+    {0x0000c06000000000ULL, 0x0000000000000000ULL},
+    {0x0003018000000000ULL, 0x0000000000000000ULL},
+    {0x000c060000000000ULL, 0x0000000000000000ULL},
+    {0x0040082000000000ULL, 0x0000000000000000ULL},
+    {0x0090084000000000ULL, 0x0000000000000000ULL},
+    {0x0110108000000000ULL, 0x0000000000000000ULL},
+    {0x0220110000000000ULL, 0x0000000000000000ULL},
+    {0x0420220000000000ULL, 0x0000000000000000ULL},
+    {0x0800240000000000ULL, 0x0000000000000000ULL},
+    {0x0181800000000000ULL, 0x0000000000000000ULL},
+    {0x0606000000000000ULL, 0x0000000000000000ULL},
+    {0x1000400000000000ULL, 0x0000000000000000ULL},
+    {0x9010800000000000ULL, 0x0000000000000000ULL},
+    {0x2011000000000000ULL, 0x0000000000000001ULL},
+    {0x2022000000000000ULL, 0x0000000000000002ULL},
+    {0x4024000000000000ULL, 0x0000000000000004ULL},
+    {0x4008000000000000ULL, 0x0000000000000000ULL},
+    {0x80c0000000000000ULL, 0x0000000000000000ULL},
+    {0x0300000000000000ULL, 0x0000000000000003ULL},
+    {0x0c00000000000000ULL, 0x0000000000000004ULL},
+    {0x1080000000000000ULL, 0x0000000000000008ULL},
+    {0x2100000000000000ULL, 0x0000000000000028ULL},
+    {0x2200000000000000ULL, 0x0000000000000050ULL},
+    {0x4400000000000000ULL, 0x0000000000000010ULL},
+    {0x8000000000000000ULL, 0x0000000000000021ULL},
+    {0x0000000000000000ULL, 0x0000000000000046ULL},
+    {0x0000000000000000ULL, 0x0000000000000089ULL},
+    {0x0000000000000000ULL, 0x0000000000000092ULL},
+    {0x0000000000000000ULL, 0x0000000000000060ULL}
+};
+
+const uint64_t arcEnds[NUM_ARCS] = {
+    0x0000000000000003ULL,
+    0x0000000000000009ULL,
+    0x0000000000000012ULL,
+    0x000000000000000cULL,
+    0x0000000000000030ULL,
+    0x0000000000000084ULL,
+    0x0000000000000108ULL,
+    0x0000000000000210ULL,
+    0x0000000000000420ULL,
+    0x00000000000000c0ULL,
+    0x0000000000000300ULL,
+    0x0000000000000c00ULL,
+    0x0000000000001040ULL,
+    0x0000000000002080ULL,
+    0x0000000000004100ULL,
+    0x0000000000008200ULL,
+    0x0000000000010400ULL,
+    0x0000000000020800ULL,
+    0x0000000000006000ULL,
+    0x0000000000018000ULL,
+    0x0000000000041000ULL,
+    0x0000000000082000ULL,
+    0x0000000000104000ULL,
+    0x0000000000208000ULL,
+    0x0000000000410000ULL,
+    0x0000000000820000ULL,
+    0x00000000000c0000ULL,
+    0x0000000000300000ULL,
+    0x0000000000c00000ULL,
+    0x0000000001040000ULL,
+    0x0000000002080000ULL,
+    0x0000000004100000ULL,
+    0x0000000008200000ULL,
+    0x0000000010400000ULL,
+    0x0000000020800000ULL,
+    0x0000000006000000ULL,
+    0x0000000018000000ULL,
+    0x0000000041000000ULL,
+    0x0000000082000000ULL,
+    0x0000000104000000ULL,
+    0x0000000208000000ULL,
+    0x0000000410000000ULL,
+    0x0000000820000000ULL,
+    0x00000000c0000000ULL,
+    0x0000000300000000ULL,
+    0x0000000c00000000ULL,
+    0x0000001040000000ULL,
+    0x0000002080000000ULL,
+    0x0000004100000000ULL,
+    0x0000008200000000ULL,
+    0x0000010400000000ULL,
+    0x0000020800000000ULL,
+    0x0000006000000000ULL,
+    0x0000018000000000ULL,
+    0x0000041000000000ULL,
+    0x0000082000000000ULL,
+    0x0000104000000000ULL,
+    0x0000208000000000ULL,
+    0x0000410000000000ULL,
+    0x0000820000000000ULL,
+    0x00000c0000000000ULL,
+    0x0000300000000000ULL,
+    0x0000c00000000000ULL,
+    0x0001080000000000ULL,
+    0x0002100000000000ULL,
+    0x0004200000000000ULL,
+    0x0008400000000000ULL,
+    0x0003000000000000ULL,
+    0x000c000000000000ULL,
+    0x0012000000000000ULL,
+    0x0024000000000000ULL,
+    0x0030000000000000ULL
+};
+
+const int vertexNeighbourStart[55] = {
+    0, 2, 4, 6, 9, 12, 14, 16, 19, 22, 25, 28,
+    30, 32, 35, 38, 41, 44, 46, 49, 52, 55, 58, 61,
+    64, 66, 69, 72, 75, 78, 80, 83, 86, 89, 92, 95,
+    98, 100, 103, 106, 109, 112, 114, 116, 119, 122, 125, 128,
+    130, 132, 135, 138, 140, 142, 144
+};
+
+const int vertexNeighbourList[144] = {
+    1, 3, 0, 4, 3, 7, 0, 2, 8, 1, 5, 9,
+    4, 10, 7, 12, 2, 6, 13, 3, 9, 14, 4, 8,
+    15, 5, 11, 16, 10, 17, 6, 18, 7, 14, 19, 8,
+    13, 20, 9, 16, 21, 10, 15, 22, 11, 23, 12, 19,
+    24, 13, 18, 25, 14, 21, 26, 15, 20, 27, 16, 23,
+    28, 17, 22, 29, 18, 30, 19, 26, 31, 20, 25, 32,
+    21, 28, 33, 22, 27, 34, 23, 35, 24, 31, 36, 25,
+    30, 37, 26, 33, 38, 27, 32, 39, 28, 35, 40, 29,
+    34, 41, 30, 42, 31, 38, 43, 32, 37, 44, 33, 40,
+    45, 34, 39, 46, 35, 47, 36, 43, 37, 42, 48, 38,
+    45, 49, 39, 44, 50, 40, 47, 51, 41, 46, 43, 49,
+    44, 48, 52, 45, 51, 53, 46, 50, 49, 53, 50, 52
+};
+
+const int vertexArcStart[55] = {
+    0, 2, 4, 6, 9, 12, 14, 16, 19, 22, 25, 28,
+    30, 32, 35, 38, 41, 44, 46, 49, 52, 55, 58, 61,
+    64, 66, 69, 72, 75, 78, 80, 83, 86, 89, 92, 95,
+    98, 100, 103, 106, 109, 112, 114, 116, 119, 122, 125, 128,
+    130, 132, 135, 138, 140, 142, 144
+};
+
+const int vertexArcList[144] = {
+    0, 1, 0, 2, 3, 5, 1, 3, 6, 2, 4, 7,
+    4, 8, 9, 12, 5, 9, 13, 6, 10, 14, 7, 10,
+    15, 8, 11, 16, 11, 17, 12, 20, 13, 18, 21, 14,
+    18, 22, 15, 19, 23, 16, 19, 24, 17, 25, 20, 26,
+    29, 21, 26, 30, 22, 27, 31, 23, 27, 32, 24, 28,
+    33, 25, 28, 34, 29, 37, 30, 35, 38, 31, 35, 39,
+    32, 36, 40, 33, 36, 41, 34, 42, 37, 43, 46, 38,
+    43, 47, 39, 44, 48, 40, 44, 49, 41, 45, 50, 42,
+    45, 51, 46, 54, 47, 52, 55, 48, 52, 56, 49, 53,
+    57, 50, 53, 58, 51, 59, 54, 60, 55, 60, 63, 56,
+    61, 64, 57, 61, 65, 58, 62, 66, 59, 62, 63, 67,
+    64, 67, 69, 65, 68, 70, 66, 68, 69, 71, 70, 71
+};
+
+const int arcNeighbourStart[73] = {
+    0, 2, 5, 8, 11, 14, 17, 21, 25, 28, 31, 35,
+    38, 40, 44, 48, 52, 56, 58, 62, 66, 69, 73, 77,
+    81, 85, 88, 92, 96, 100, 103, 107, 111, 115, 119, 122,
+    126, 130, 133, 137, 141, 145, 149, 152, 156, 160, 164, 167,
+    171, 175, 179, 183, 186, 190, 194, 196, 200, 204, 208, 212,
+    214, 217, 221, 224, 227, 231, 235, 238, 241, 244, 247, 250,
+    252
+};
+
+const int arcNeighbourList[252] = {
+    1, 2, 0, 3, 6, 0, 4, 7, 1, 5, 6, 2,
+    7, 8, 3, 9, 13, 1, 3, 10, 14, 2, 4, 10,
+    15, 4, 11, 16, 5, 12, 13, 6, 7, 14, 15, 8,
+    16, 17, 9, 20, 5, 9, 18, 21, 6, 10, 18, 22,
+    7, 10, 19, 23, 8, 11, 19, 24, 11, 25, 13, 14,
+    21, 22, 15, 16, 23, 24, 12, 26, 29, 13, 18, 26,
+    30, 14, 18, 27, 31, 15, 19, 27, 32, 16, 19, 28,
+    33, 17, 28, 34, 20, 21, 29, 30, 22, 23, 31, 32,
+    24, 25, 33, 34, 20, 26, 37, 21, 26, 35, 38, 22,
+    27, 35, 39, 23, 27, 36, 40, 24, 28, 36, 41, 25,
+    28, 42, 30, 31, 38, 39, 32, 33, 40, 41, 29, 43,
+    46, 30, 35, 43, 47, 31, 35, 44, 48, 32, 36, 44,
+    49, 33, 36, 45, 50, 34, 45, 51, 37, 38, 46, 47,
+    39, 40, 48, 49, 41, 42, 50, 51, 37, 43, 54, 38,
+    43, 52, 55, 39, 44, 52, 56, 40, 44, 53, 57, 41,
+    45, 53, 58, 42, 45, 59, 47, 48, 55, 56, 49, 50,
+    57, 58, 46, 60, 47, 52, 60, 63, 48, 52, 61, 64,
+    49, 53, 61, 65, 50, 53, 62, 66, 51, 62, 54, 55,
+    63, 56, 57, 64, 65, 58, 59, 66, 55, 60, 67, 56,
+    61, 67, 69, 57, 61, 68, 70, 58, 62, 68, 63, 64,
+    69, 65, 66, 70, 64, 67, 71, 65, 68, 71, 69, 70
+};
+
+const int arcEndStart[73] = {
+    0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22,
+    24, 26, 28, 30, 32, 34, 36, 38, 40, 42, 44, 46,
+    48, 50, 52, 54, 56, 58, 60, 62, 64, 66, 68, 70,
+    72, 74, 76, 78, 80, 82, 84, 86, 88, 90, 92, 94,
+    96, 98, 100, 102, 104, 106, 108, 110, 112, 114, 116, 118,
+    120, 122, 124, 126, 128, 130, 132, 134, 136, 138, 140, 142,
+    144
+};
+
+const int arcEndList[144] = {
+    0, 1, 0, 3, 1, 4, 2, 3, 4, 5, 2, 7,
+    3, 8, 4, 9, 5, 10, 6, 7, 8, 9, 10, 11,
+    6, 12, 7, 13, 8, 14, 9, 15, 10, 16, 11, 17,
+    13, 14, 15, 16, 12, 18, 13, 19, 14, 20, 15, 21,
+    16, 22, 17, 23, 18, 19, 20, 21, 22, 23, 18, 24,
+    19, 25, 20, 26, 21, 27, 22, 28, 23, 29, 25, 26,
+    27, 28, 24, 30, 25, 31, 26, 32, 27, 33, 28, 34,
+    29, 35, 30, 31, 32, 33, 34, 35, 30, 36, 31, 37,
+    32, 38, 33, 39, 34, 40, 35, 41, 37, 38, 39, 40,
+    36, 42, 37, 43, 38, 44, 39, 45, 40, 46, 41, 47,
+    42, 43, 44, 45, 46, 47, 43, 48, 44, 49, 45, 50,
+    46, 51, 48, 49, 50, 51, 49, 52, 50, 53, 52, 53
+};
+
+const int vertexRegionStart[55] = {
+    0, 1, 2, 3, 5, 7, 8, 9, 11, 14, 17, 19,
+    20, 21, 24, 27, 30, 33, 34, 36, 39, 42, 45, 48,
+    50, 51, 54, 57, 60, 63, 64, 66, 69, 72, 75, 78,
+    80, 81, 84, 87, 90, 93, 94, 95, 97, 100, 103, 105,
+    106, 107, 109, 111, 112, 113, 114
+};
+
+const int vertexRegionList[114] = {
+    7, 7, 3, 7, 3, 7, 12, 12, 0, 3, 0, 7,
+    3, 8, 7, 12, 8, 12, 16, 16, 0, 3, 0, 4,
+    3, 8, 4, 12, 8, 13, 12, 16, 13, 16, 0, 1,
+    0, 4, 1, 8, 4, 9, 8, 13, 9, 16, 13, 17,
+    16, 17, 1, 4, 1, 5, 4, 9, 5, 13, 9, 14,
+    13, 17, 14, 17, 1, 2, 1, 5, 2, 9, 5, 10,
+    9, 14, 10, 17, 14, 18, 17, 18, 2, 5, 2, 6,
+    5, 10, 6, 14, 10, 15, 14, 18, 15, 18, 2, 2,
+    6, 10, 6, 11, 10, 15, 11, 18, 15, 18, 6, 6,
+    11, 15, 11, 15, 11, 11
+};
+
+const int regionVertexStart[20] = {
+    0, 6, 12, 18, 24, 30, 36, 42, 48, 54, 60, 66,
+    72, 78, 84, 90, 96, 102, 108, 114
+};
+
+const int regionVertexList[114] = {
+    6, 7, 12, 13, 18, 19, 18, 19, 24, 25, 30, 31,
+    30, 31, 36, 37, 42, 43, 2, 3, 7, 8, 13, 14,
+    13, 14, 19, 20, 25, 26, 25, 26, 31, 32, 37, 38,
+    37, 38, 43, 44, 48, 49, 0, 1, 3, 4, 8, 9,
+    8, 9, 14, 15, 20, 21, 20, 21, 26, 27, 32, 33,
+    32, 33, 38, 39, 44, 45, 44, 45, 49, 50, 52, 53,
+    4, 5, 9, 10, 15, 16, 15, 16, 21, 22, 27, 28,
+    27, 28, 33, 34, 39, 40, 39, 40, 45, 46, 50, 51,
+    10, 11, 16, 17, 22, 23, 22, 23, 28, 29, 34, 35,
+    34, 35, 40, 41, 46, 47
+};
+
+const int vertexRetrainDiscipline[NUM_VERTICES] = {
+    -1, -1, 4, 4, 5, 5, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, 2, -1, -1, -1, -1, -1, 2,
+    -1, -1, -1, -1, -1, -1, -1, 1, -1, -1, 3, -1,
+    1, -1, -1, 3, -1, -1
+};
+
+const signed char stepClasses[256] = {
+    4, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 2, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 0, 3, 3, 3, 3, 3, 1, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3
+};
+
+const short pathTransitions[NUM_PATH_STATES][NUM_STEP_CLASSES] = {
+    {217, 7, 13, 217, 0},
+    {7, 13, 217, 217, 1},
+    {13, 217, 7, 217, 2},
+    {217, 13, 217, 217, 3},
+    {2, 217, 17, 217, 4},
+    {17, 2, 217, 217, 5},
+    {17, 217, 217, 217, 6},
+    {217, 17, 2, 217, 7},
+    {217, 15, 29, 217, 8},
+    {15, 29, 217, 217, 9},
+    {29, 217, 15, 217, 10},
+    {217, 29, 217, 217, 11},
+    {10, 0, 33, 217, 12},
+    {33, 10, 0, 217, 13},
+    {33, 0, 19, 217, 14},
+    {0, 33, 10, 217, 15},
+    {4, 23, 37, 217, 16},
+    {23, 37, 4, 217, 17},
+    {37, 4, 23, 217, 18},
+    {4, 37, 14, 217, 19},
+    {18, 217, 41, 217, 20},
+    {41, 18, 217, 217, 21},
+    {41, 217, 217, 217, 22},
+    {217, 41, 18, 217, 23},
+    {217, 31, 49, 217, 24},
+    {31, 49, 217, 217, 25},
+    {49, 217, 31, 217, 26},
+    {217, 49, 217, 217, 27},
+    {26, 8, 53, 217, 28},
+    {53, 26, 8, 217, 29},
+    {53, 8, 35, 217, 30},
+    {8, 53, 26, 217, 31},
+    {12, 39, 57, 217, 32},
+    {39, 57, 12, 217, 33},
+    {57, 12, 39, 217, 34},
+    {12, 57, 30, 217, 35},
+    {34, 16, 61, 217, 36},
+    {61, 34, 16, 217, 37},
+    {61, 16, 43, 217, 38},
+    {16, 61, 34, 217, 39},
+    {20, 47, 65, 217, 40},
+    {47, 65, 20, 217, 41},
+    {65, 20, 47, 217, 42},
+    {20, 65, 38, 217, 43},
+    {42, 217, 69, 217, 44},
+    {69, 42, 217, 217, 45},
+    {69, 217, 217, 217, 46},
+    {217, 69, 42, 217, 47},
+    {217, 24, 73, 217, 48},
+    {73, 217, 24, 217, 49},
+    {73, 24, 55, 217, 50},
+    {24, 73, 217, 217, 51},
+    {28, 59, 77, 217, 52},
+    {59, 77, 28, 217, 53},
+    {77, 28, 59, 217, 54},
+    {28, 77, 50, 217, 55},
+    {54, 32, 81, 217, 56},
+    {81, 54, 32, 217, 57},
+    {81, 32, 63, 217, 58},
+    {32, 81, 54, 217, 59},
+    {36, 67, 85, 217, 60},
+    {67, 85, 36, 217, 61},
+    {85, 36, 67, 217, 62},
+    {36, 85, 58, 217, 63},
+    {62, 40, 89, 217, 64},
+    {89, 62, 40, 217, 65},
+    {89, 40, 71, 217, 66},
+    {40, 89, 62, 217, 67},
+    {44, 217, 93, 217, 68},
+    {217, 93, 44, 217, 69},
+    {93, 44, 217, 217, 70},
+    {44, 93, 66, 217, 71},
+    {48, 79, 97, 217, 72},
+    {79, 97, 48, 217, 73},
+    {97, 48, 79, 217, 74},
+    {48, 97, 217, 217, 75},
+    {74, 52, 101, 217, 76},
+    {101, 74, 52, 217, 77},
+    {101, 52, 83, 217, 78},
+    {52, 101, 74, 217, 79},
+    {56, 87, 105, 217, 80},
+    {87, 105, 56, 217, 81},
+    {105, 56, 87, 217, 82},
+    {56, 105, 78, 217, 83},
+    {82, 60, 109, 217, 84},
+    {109, 82, 60, 217, 85},
+    {109, 60, 91, 217, 86},
+    {60, 109, 82, 217, 87},
+    {64, 95, 113, 217, 88},
+    {95, 113, 64, 217, 89},
+    {113, 64, 95, 217, 90},
+    {64, 113, 86, 217, 91},
+    {90, 68, 117, 217, 92},
+    {117, 90, 68, 217, 93},
+    {117, 68, 217, 217, 94},
+    {68, 117, 90, 217, 95},
+    {217, 72, 121, 217, 96},
+    {121, 217, 72, 217, 97},
+    {121, 72, 103, 217, 98},
+    {72, 121, 217, 217, 99},
+    {76, 107, 125, 217, 100},
+    {107, 125, 76, 217, 101},
+    {125, 76, 107, 217, 102},
+    {76, 125, 98, 217, 103},
+    {102, 80, 129, 217, 104},
+    {129, 102, 80, 217, 105},
+    {129, 80, 111, 217, 106},
+    {80, 129, 102, 217, 107},
+    {84, 115, 133, 217, 108},
+    {115, 133, 84, 217, 109},
+    {133, 84, 115, 217, 110},
+    {84, 133, 106, 217, 111},
+    {110, 88, 137, 217, 112},
+    {137, 110, 88, 217, 113},
+    {137, 88, 119, 217, 114},
+    {88, 137, 110, 217, 115},
+    {92, 217, 141, 217, 116},
+    {217, 141, 92, 217, 117},
+    {141, 92, 217, 217, 118},
+    {92, 141, 114, 217, 119},
+    {96, 127, 145, 217, 120},
+    {127, 145, 96, 217, 121},
+    {145, 96, 127, 217, 122},
+    {96, 145, 217, 217, 123},
+    {122, 100, 149, 217, 124},
+    {149, 122, 100, 217, 125},
+    {149, 100, 131, 217, 126},
+    {100, 149, 122, 217, 127},
+    {104, 135, 153, 217, 128},
+    {135, 153, 104, 217, 129},
+    {153, 104, 135, 217, 130},
+    {104, 153, 126, 217, 131},
+    {130, 108, 157, 217, 132},
+    {157, 130, 108, 217, 133},
+    {157, 108, 139, 217, 134},
+    {108, 157, 130, 217, 135},
+    {112, 143, 161, 217, 136},
+    {143, 161, 112, 217, 137},
+    {161, 112, 143, 217, 138},
+    {112, 161, 134, 217, 139},
+    {138, 116, 165, 217, 140},
+    {165, 138, 116, 217, 141},
+    {165, 116, 217, 217, 142},
+    {116, 165, 138, 217, 143},
+    {217, 120, 169, 217, 144},
+    {169, 217, 120, 217, 145},
+    {169, 120, 151, 217, 146},
+    {120, 169, 217, 217, 147},
+    {124, 155, 173, 217, 148},
+    {155, 173, 124, 217, 149},
+    {173, 124, 155, 217, 150},
+    {124, 173, 146, 217, 151},
+    {150, 128, 177, 217, 152},
+    {177, 150, 128, 217, 153},
+    {177, 128, 159, 217, 154},
+    {128, 177, 150, 217, 155},
+    {132, 163, 181, 217, 156},
+    {163, 181, 132, 217, 157},
+    {181, 132, 163, 217, 158},
+    {132, 181, 154, 217, 159},
+    {158, 136, 185, 217, 160},
+    {185, 158, 136, 217, 161},
+    {185, 136, 167, 217, 162},
+    {136, 185, 158, 217, 163},
+    {140, 217, 189, 217, 164},
+    {217, 189, 140, 217, 165},
+    {189, 140, 217, 217, 166},
+    {140, 189, 162, 217, 167},
+    {144, 175, 217, 217, 168},
+    {175, 217, 144, 217, 169},
+    {217, 144, 175, 217, 170},
+    {144, 217, 217, 217, 171},
+    {170, 148, 193, 217, 172},
+    {193, 170, 148, 217, 173},
+    {193, 148, 179, 217, 174},
+    {148, 193, 170, 217, 175},
+    {152, 183, 197, 217, 176},
+    {183, 197, 152, 217, 177},
+    {197, 152, 183, 217, 178},
+    {152, 197, 174, 217, 179},
+    {178, 156, 201, 217, 180},
+    {201, 178, 156, 217, 181},
+    {201, 156, 187, 217, 182},
+    {156, 201, 178, 217, 183},
+    {160, 191, 205, 217, 184},
+    {191, 205, 160, 217, 185},
+    {205, 160, 191, 217, 186},
+    {160, 205, 182, 217, 187},
+    {186, 164, 217, 217, 188},
+    {217, 186, 164, 217, 189},
+    {217, 164, 217, 217, 190},
+    {164, 217, 186, 217, 191},
+    {172, 199, 217, 217, 192},
+    {199, 217, 172, 217, 193},
+    {217, 172, 199, 217, 194},
+    {172, 217, 217, 217, 195},
+    {194, 176, 209, 217, 196},
+    {209, 194, 176, 217, 197},
+    {209, 176, 203, 217, 198},
+    {176, 209, 194, 217, 199},
+    {180, 207, 213, 217, 200},
+    {207, 213, 180, 217, 201},
+    {213, 180, 207, 217, 202},
+    {180, 213, 198, 217, 203},
+    {202, 184, 217, 217, 204},
+    {217, 202, 184, 217, 205},
+    {217, 184, 217, 217, 206},
+    {184, 217, 202, 217, 207},
+    {196, 215, 217, 217, 208},
+    {215, 217, 196, 217, 209},
+    {217, 196, 215, 217, 210},
+    {196, 217, 217, 217, 211},
+    {210, 200, 217, 217, 212},
+    {217, 210, 200, 217, 213},
+    {217, 200, 217, 217, 214},
+    {200, 217, 210, 217, 215},
+    {7, 13, 217, 217, 216},
+    {217, 217, 217, 217, 217}
+};
+
+const short pathStateVertex[NUM_PATH_STATES] = {
+    0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5,
+    6, 6, 6, 6, 7, 7, 7, 7, 8, 8, 8, 8,
+    9, 9, 9, 9, 10, 10, 10, 10, 11, 11, 11, 11,
+    12, 12, 12, 12, 13, 13, 13, 13, 14, 14, 14, 14,
+    15, 15, 15, 15, 16, 16, 16, 16, 17, 17, 17, 17,
+    18, 18, 18, 18, 19, 19, 19, 19, 20, 20, 20, 20,
+    21, 21, 21, 21, 22, 22, 22, 22, 23, 23, 23, 23,
+    24, 24, 24, 24, 25, 25, 25, 25, 26, 26, 26, 26,
+    27, 27, 27, 27, 28, 28, 28, 28, 29, 29, 29, 29,
+    30, 30, 30, 30, 31, 31, 31, 31, 32, 32, 32, 32,
+    33, 33, 33, 33, 34, 34, 34, 34, 35, 35, 35, 35,
+    36, 36, 36, 36, 37, 37, 37, 37, 38, 38, 38, 38,
+    39, 39, 39, 39, 40, 40, 40, 40, 41, 41, 41, 41,
+    42, 42, 42, 42, 43, 43, 43, 43, 44, 44, 44, 44,
+    45, 45, 45, 45, 46, 46, 46, 46, 47, 47, 47, 47,
+    48, 48, 48, 48, 49, 49, 49, 49, 50, 50, 50, 50,
+    51, 51, 51, 51, 52, 52, 52, 52, 53, 53, 53, 53,
+    0, -1
+};
+
+const short pathStateArc[NUM_PATH_STATES] = {
+    1, -1, 0, -1, 2, -1, -1, 0, 5, -1, 3, -1,
+    6, 1, -1, 3, 7, 2, 4, -1, 8, -1, -1, 4,
+    12, -1, 9, -1, 13, 5, -1, 9, 14, 6, 10, -1,
+    15, 7, -1, 10, 16, 8, 11, -1, 17, -1, -1, 11,
+    20, 12, -1, -1, 21, 13, 18, -1, 22, 14, -1, 18,
+    23, 15, 19, -1, 24, 16, -1, 19, 25, 17, -1, -1,
+    29, 20, 26, -1, 30, 21, -1, 26, 31, 22, 27, -1,
+    32, 23, -1, 27, 33, 24, 28, -1, 34, 25, -1, 28,
+    37, 29, -1, -1, 38, 30, 35, -1, 39, 31, -1, 35,
+    40, 32, 36, -1, 41, 33, -1, 36, 42, 34, -1, -1,
+    46, 37, 43, -1, 47, 38, -1, 43, 48, 39, 44, -1,
+    49, 40, -1, 44, 50, 41, 45, -1, 51, 42, -1, 45,
+    54, 46, -1, -1, 55, 47, 52, -1, 56, 48, -1, 52,
+    57, 49, 53, -1, 58, 50, -1, 53, 59, 51, -1, -1,
+    -1, 54, 60, -1, 63, 55, -1, 60, 64, 56, 61, -1,
+    65, 57, -1, 61, 66, 58, 62, -1, -1, 59, -1, 62,
+    -1, 63, 67, -1, 69, 64, -1, 67, 70, 65, 68, -1,
+    -1, 66, -1, 68, -1, 69, 71, -1, -1, 70, -1, 71,
+    -1, -1
+};
+
+const char *const vertexPaths[NUM_VERTICES] = {
+    "",
+    "L",
+    "RR",
+    "R",
+    "LR",
+    "LRL",
+    "RRLR",
+    "RRL",
+    "RL",
+    "LRR",
+    "LRLR",
+    "LRLRL",
+    "RRLRL",
+    "RLRR",
+    "RLR",
+    "LRRL",
+    "LRLRR",
+    "LRLRLR",
+    "RLRRLR",
+    "RLRRL",
+    "RLRL",
+    "LRRLR",
+    "LRLRRL",
+    "LRLRLRR",
+    "RLRRLRL",
+    "RLRLRR",
+    "RLRLR",
+    "LRRLRL",
+    "LRLRRLR",
+    "LRLRLRRL",
+    "RLRLRRLR",
+    "RLRLRRL",
+    "RLRLRL",
+    "LRRLRLR",
+    "LRLRRLRL",
+    "LRLRLRRLR",
+    "RLRLRRLRL",
+    "RLRLRLRR",
+    "RLRLRLR",
+    "LRRLRLRL",
+    "LRLRRLRLR",
+    "LRLRLRRLRL",
+    "RLRLRLRRLR",
+    "RLRLRLRRL",
+    "RLRLRLRL",
+    "LRRLRLRLR",
+    "LRLRRLRLRL",
+    "LRLRLRRLRLR",
+    "RLRLRLRLRR",
+    "RLRLRLRLR",
+    "LRRLRLRLRL",
+    "LRLRRLRLRLR",
+    "RLRLRLRLRL",
+    "LRRLRLRLRLR"
+};
+
+const char *const arcPaths[NUM_ARCS] = {
+    "L",
+    "R",
+    "LR",
+    "RR",
+    "LRL",
+    "RRL",
+    "RL",
+    "LRR",
+    "LRLR",
+    "RRLR",
+    "RLL",
+    "LRLRL",
+    "RRLRL",
+    "RRLL",
+    "RLR",
+    "LRRL",
+    "LRLRR",
+    "LRLRLR",
+    "RLRR",
+    "LRRLL",
+    "RRLRLL",
+    "RLRRL",
+    "RLRL",
+    "LRRLR",
+    "LRLRRL",
+    "LRLRLRR",
+    "RLRRLR",
+    "RLRLL",
+    "LRLRRLL",
+    "RLRRLRL",
+    "RLRRLL",
+    "RLRLR",
+    "LRRLRL",
+    "LRLRRLR",
+    "LRLRLRRL",
+    "RLRLRR",
+    "LRRLRLL",
+    "RLRRLRLL",
+    "RLRLRRL",
+    "RLRLRL",
+    "LRRLRLR",
+    "LRLRRLRL",
+    "LRLRLRRLR",
+    "RLRLRRLR",
+    "RLRLRLL",
+    "LRLRRLRLL",
+    "RLRLRRLRL",
+    "RLRLRRLL",
+    "RLRLRLR",
+    "LRRLRLRL",
+    "LRLRRLRLR",
+    "LRLRLRRLRL",
+    "RLRLRLRR",
+    "LRRLRLRLL",
+    "RLRLRRLRLL",
+    "RLRLRLRRL",
+    "RLRLRLRL",
+    "LRRLRLRLR",
+    "LRLRRLRLRL",
+    "LRLRLRRLRLR",
+    "RLRLRLRRLR",
+    "RLRLRLRLL",
+    "LRLRRLRLRLL",
+    "RLRLRLRRLL",
+    "RLRLRLRLR",
+    "LRRLRLRLRL",
+    "LRLRRLRLRLR",
+    "RLRLRLRLRR",
+    "LRRLRLRLRLL",
+    "RLRLRLRLRL",
+    "LRRLRLRLRLR",
+    "RLRLRLRLRLL"
+};
+
@@ -0,0 +1,688 @@
+/*
+ * expectimax.c
+ * A depth limited expectimax AI for Knowledge Island
+ *
+ * Copyright 2015 Simon Shields, Harrison Shoebridge, Julian Tu and James Ye
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <stdint.h>
+#include "Game.h"
+#include "GameExt.h"
+#include "boardAnalysis.h"
+#include "transTable.h"
+#include "expectimax.h"
+
+#define WINNING_KPI 150
+
+#define MIN_DICE_VALUE 2
+#define MAX_DICE_VALUE 12
+#define NUM_DICE_VALUES (MAX_DICE_VALUE - MIN_DICE_VALUE + 1)
+#define NUM_SPINOFF_OUTCOMES 2
+#define MAX_OUTCOMES NUM_DICE_VALUES
+
+#define DEFAULT_MAX_DEPTH 8
+#define DEFAULT_TURN_ACTIONS 3
+#define DEFAULT_NODE_BUDGET 20000
+#define DEFAULT_TABLE_BYTES (4 << 20)
+
+// how many nodes are searched between looks at the clock
+#define CLOCK_INTERVAL 256
+
+// a position is scored by its KPIs, plus what its campuses should
+// produce, the best place it could build a campus next and the
+// students it holds. every university's share of the
+// total is its value, so the values always add up to 1
+#define PRODUCTION_WEIGHT 20.0f
+#define SITE_WEIGHT 10.0f
+#define STUDENT_WEIGHT 0.5f
+#define BASE_SCORE 1.0f
+
+// how far a player's static share can be below what a Star2 probe
+// needs from them and still be worth probing
+#define PROBE_MARGIN 0.1f
+
+// the threshold for a search where every value matters
+#define NO_BOUND -1.0f
+
+// mixed into a position's key once per action left in the turn, so
+// the same position with a different number of actions left, which
+// has a different game tree below it, gets its own entry
+#define ACTIONS_KEY 0x9E3779B97F4A7C15ULL
+
+// not any move that can be generated, for orderMoves()
+#define NO_MOVE ENCODE_MOVE(PASS, MOVE_NO_TARGET)
+
+typedef struct _search {
+    Game g;
+    TransTable table;
+    BoardInfo board;
+    long nodes;
+    long tableHits;
+    long nodeLimit;
+    double deadline;
+    int canStop;
+    int stopped;
+} search;
+
+// one of each per thread, so games on different threads can each
+// have their own searches
+static __thread expectimaxConfig config = {
+    DEFAULT_MAX_DEPTH, DEFAULT_TURN_ACTIONS, DEFAULT_NODE_BUDGET, 0,
+    DEFAULT_TABLE_BYTES, FALSE, FALSE
+};
+static __thread expectimaxStats lastStats;
+static __thread TransTable table = NULL;
+static __thread size_t tableBytes = 0;
+
+static int maxNode(search *s, int depth, int actionsLeft, int bound,
+                   float alpha, float v[NUM_UNIS], move *bestMove);
+static int searchMove(search *s, move m, int depth, int actionsLeft,
+                      int bound, float alpha, float v[NUM_UNIS]);
+static int chanceNode(search *s, int isDice, int depth,
+                      int actionsLeft, int bound, float alpha,
+                      float v[NUM_UNIS]);
+static void probeNode(search *s, int depth, int actionsLeft,
+                      float v[NUM_UNIS]);
+static int listOutcomes(int isDice, int outcomes[], float chances[]);
+static void applyOutcome(Game g, int isDice, int outcome,
+                         undoRecord *undo);
+static void undoOutcome(Game g, int isDice, const undoRecord *undo);
+static int orderMoves(search *s, move moves[], move first,
+                      int actionsLeft);
+static float moveScore(search *s, move m);
+static int lookUp(search *s, uint64_t key, int depth, int bound,
+                  float alpha, float v[NUM_UNIS], int *exact);
+static void storeResult(search *s, uint64_t key, int depth, int bound,
+                        const float v[NUM_UNIS], int exact);
+static void evaluate(search *s, float v[NUM_UNIS]);
+static int findWinner(Game g);
+static void failLow(int bound, float upper, float v[NUM_UNIS]);
+static int outOfBudget(search *s);
+static double secondsNow(void);
+
+void getDefaultExpectimaxConfig(expectimaxConfig *c) {
+    c->maxDepth = DEFAULT_MAX_DEPTH;
+    c->maxTurnActions = DEFAULT_TURN_ACTIONS;
+    c->nodeBudget = DEFAULT_NODE_BUDGET;
+    c->timeBudgetMs = 0;
+    c->tableBytes = DEFAULT_TABLE_BYTES;
+    c->keepTable = FALSE;
+    c->verbose = FALSE;
+}
+
+void setExpectimaxConfig(const expectimaxConfig *c) {
+    config = *c;
+}
+
+expectimaxStats getLastExpectimaxStats(void) {
+    return lastStats;
+}
+
+void disposeExpectimax(void) {
+    if (table != NULL) {
+        disposeTransTable(table);
+    }
+    table = NULL;
+    tableBytes = 0;
+}
+
+#ifdef EXPECTIMAX_DECIDE_ACTION
+action decideAction(Game g) {
+    return decideActionExpectimax(g);
+}
+#endif
+
+action decideActionExpectimax(Game g) {
+    action best = {PASS, "", 0, 0};
+    memset(&lastStats, 0, sizeof(lastStats));
+
+    move moves[MAX_LEGAL_MOVES];
+    if (generateLegalActions(g, moves, MAX_LEGAL_MOVES) > 0) {
+        if (tableBytes != config.tableBytes) {
+            disposeExpectimax();
+            if (config.tableBytes > 0) {
+                table = newTransTable(config.tableBytes);
+            }
+            tableBytes = config.tableBytes;
+        }
+        if (table != NULL && config.keepTable) {
+            ageTransTable(table);
+        } else if (table != NULL) {
+            clearTransTable(table);
+        }
+
+        search s;
+        s.g = cloneGame(g);
+        s.table = table;
+        s.nodes = 0;
+        s.tableHits = 0;
+        s.nodeLimit = config.nodeBudget;
+        double start = secondsNow();
+        s.deadline = 0;
+        if (config.timeBudgetMs > 0) {
+            s.deadline = start + config.timeBudgetMs / 1000.0;
+        }
+        s.stopped = FALSE;
+        s.board = getBoardInfo(g);
+
+        // deepen one turn at a time, starting each search with the
+        // last one's choice. the first search always finishes so
+        // there is always something to play
+        move chosen = moves[0];
+        int depth = 1;
+        while (depth <= config.maxDepth && !s.stopped) {
+            s.canStop = depth > 1;
+            move searched = chosen;
+            float v[NUM_UNIS];
+            maxNode(&s, depth, config.maxTurnActions, NO_ONE, NO_BOUND,
+                    v, &searched);
+            if (!s.stopped) {
+                chosen = searched;
+                lastStats.depth = depth;
+            }
+            depth++;
+        }
+        best = moveToAction(chosen);
+
+        lastStats.nodes = s.nodes;
+        lastStats.tableHits = s.tableHits;
+        lastStats.seconds = secondsNow() - start;
+        if (config.verbose) {
+            fprintf(stderr, "expectimax: depth %d, %ld nodes, "
+                    "%ld table hits in %.3fs\n", lastStats.depth,
+                    s.nodes, s.tableHits, lastStats.seconds);
+        }
+        releaseBoardInfo(s.board);
+        disposeGame(s.g);
+    }
+    return best;
+}
+
+// the position after the player to move picks the move that is best
+// for them (max^n), looking depth turns ahead counting this one and
+// with actionsLeft more actions before they have to pass. the caller
+// only cares whether bound ends up with more than alpha here. returns
+// TRUE with the exact values, or FALSE with v[bound-1] an upper bound
+// no more than alpha. bestMove, if given, is searched first and set
+// to the move chosen
+static int maxNode(search *s, int depth, int actionsLeft, int bound,
+                   float alpha, float v[NUM_UNIS], move *bestMove) {
+    Game g = s->g;
+    int exact = TRUE;
+    s->nodes++;
+    int winner = findWinner(g);
+    if (winner != NO_ONE) {
+        int uni = UNI_A;
+        while (uni <= UNI_C) {
+            v[uni-1] = (uni == winner);
+            uni++;
+        }
+    } else if (depth == 0 || outOfBudget(s)) {
+        evaluate(s, v);
+    } else {
+        uint64_t key = getCanonicalHash(g) ^ actionsLeft * ACTIONS_KEY;
+        if (bestMove != NULL ||
+                !lookUp(s, key, depth, bound, alpha, v, &exact)) {
+            int mover = getWhoseTurn(g);
+            move moves[MAX_LEGAL_MOVES + 1];
+            move first = NO_MOVE;
+            if (bestMove != NULL) {
+                first = *bestMove;
+            }
+            int count = orderMoves(s, moves, first, actionsLeft);
+
+            float best[NUM_UNIS];
+            int haveBest = FALSE;
+            int cut = FALSE;
+            int i = 0;
+            while (i < count && !cut && !s->stopped) {
+                // what a move has to beat to make a difference here.
+                // while the caller's player is choosing that is the
+                // caller's alpha too
+                int childBound = mover;
+                float childAlpha = NO_BOUND;
+                if (haveBest) {
+                    childAlpha = best[mover-1];
+                }
+                if (mover == bound && alpha > childAlpha) {
+                    childAlpha = alpha;
+                }
+                float childV[NUM_UNIS];
+                int childExact = searchMove(s, moves[i], depth,
+                                            actionsLeft, childBound,
+                                            childAlpha, childV);
+                if (childExact && (!haveBest ||
+                        childV[mover-1] > best[mover-1])) {
+                    memcpy(best, childV, sizeof(best));
+                    haveBest = TRUE;
+                    if (bestMove != NULL) {
+                        *bestMove = moves[i];
+                    }
+                    // shallow pruning: the values add up to 1, so
+                    // once the mover has this much the caller's
+                    // player can't get more than alpha
+                    if (bound != NO_ONE && bound != mover &&
+                            best[mover-1] >= 1 - alpha) {
+                        cut = TRUE;
+                    }
+                }
+                i++;
+            }
+
+            if (!haveBest || (mover == bound &&
+                    best[mover-1] <= alpha)) {
+                // some moves may only be known to be no better than
+                // alpha, so that is all that is known here too
+                failLow(bound, alpha, v);
+                exact = FALSE;
+            } else {
+                memcpy(v, best, sizeof(best));
+                exact = !cut;
+            }
+            if (!s->stopped) {
+                storeResult(s, key, depth, bound, v, exact);
+            }
+        }
+    }
+    return exact;
+}
+
+// plays m and searches what follows, like maxNode(). passing ends
+// the turn, and the next player starts theirs with a full set of
+// actions
+static int searchMove(search *s, move m, int depth, int actionsLeft,
+                      int bound, float alpha, float v[NUM_UNIS]) {
+    int exact;
+    if (m == ENCODE_MOVE(PASS, 0)) {
+        exact = chanceNode(s, TRUE, depth - 1, config.maxTurnActions,
+                           bound, alpha, v);
+    } else if (MOVE_CODE(m) == START_SPINOFF) {
+        exact = chanceNode(s, FALSE, depth, actionsLeft - 1, bound,
+                           alpha, v);
+    } else {
+        undoRecord undo;
+        makeMoveWithUndo(s->g, m, &undo);
+        exact = maxNode(s, depth, actionsLeft - 1, bound, alpha, v,
+                        NULL);
+        unmakeAction(s->g, &undo);
+    }
+    return exact;
+}
+
+// the average over every dice roll, or both ways a spinoff can go,
+// weighted by how likely each is. Star2 first probes one move after
+// each outcome for a cheap upper bound on each, and Star1 keeps a
+// running bound on the average as the outcomes are searched in
+// full. either can show the caller's player can't beat alpha here
+static int chanceNode(search *s, int isDice, int depth,
+                      int actionsLeft, int bound, float alpha,
+                      float v[NUM_UNIS]) {
+    int outcomes[MAX_OUTCOMES];
+    float chances[MAX_OUTCOMES];
+    float upper[MAX_OUTCOMES];
+    int count = listOutcomes(isDice, outcomes, chances);
+    float upperTotal = 0;
+    int i = 0;
+    while (i < count) {
+        upper[i] = 1;
+        upperTotal += chances[i];
+        i++;
+    }
+
+    // a probe bounds the caller's player by what the next player is
+    // sure to get, so it only pays when the next player looks strong
+    // enough to leave them no more than alpha
+    int next = getWhoseTurn(s->g);
+    if (isDice) {
+        next = next % NUM_UNIS + 1;
+    }
+    int worthProbing = FALSE;
+    if (bound != NO_ONE && bound != next && depth > 0) {
+        float estimate[NUM_UNIS];
+        evaluate(s, estimate);
+        worthProbing = estimate[next-1] >= 1 - alpha - PROBE_MARGIN;
+    }
+
+    int exact = TRUE;
+    if (worthProbing) {
+        upperTotal = 0;
+        i = 0;
+        while (i < count) {
+            undoRecord undo;
+            applyOutcome(s->g, isDice, outcomes[i], &undo);
+            if (getWhoseTurn(s->g) != bound) {
+                // the next player gets at least what the probe found
+                float probe[NUM_UNIS];
+                probeNode(s, depth, actionsLeft, probe);
+                upper[i] = 1 - probe[getWhoseTurn(s->g)-1];
+            }
+            undoOutcome(s->g, isDice, &undo);
+            upperTotal += chances[i] * upper[i];
+            i++;
+        }
+        if (upperTotal <= alpha) {
+            failLow(bound, upperTotal, v);
+            exact = FALSE;
+        }
+    }
+
+    float total[NUM_UNIS] = {0, 0, 0};
+    float searched = 0;
+    i = 0;
+    while (exact && i < count && !s->stopped) {
+        upperTotal -= chances[i] * upper[i];
+        float childAlpha = NO_BOUND;
+        if (bound != NO_ONE) {
+            childAlpha = (alpha - searched - upperTotal) / chances[i];
+        }
+        undoRecord undo;
+        applyOutcome(s->g, isDice, outcomes[i], &undo);
+        float childV[NUM_UNIS];
+        int childExact = maxNode(s, depth, actionsLeft, bound,
+                                 childAlpha, childV, NULL);
+        undoOutcome(s->g, isDice, &undo);
+        if (bound != NO_ONE) {
+            searched += chances[i] * childV[bound-1];
+        }
+        if (!childExact || (bound != NO_ONE &&
+                searched + upperTotal <= alpha)) {
+            failLow(bound, searched + upperTotal, v);
+            exact = FALSE;
+        } else {
+            int uni = 0;
+            while (uni < NUM_UNIS) {
+                total[uni] += chances[i] * childV[uni];
+                uni++;
+            }
+        }
+        i++;
+    }
+    if (exact) {
+        memcpy(v, total, sizeof(total));
+    }
+    return exact;
+}
+
+// the values after the first move in order, which is no more than the
+// player to move can get here
+static void probeNode(search *s, int depth, int actionsLeft,
+                      float v[NUM_UNIS]) {
+    if (findWinner(s->g) != NO_ONE || depth == 0) {
+        maxNode(s, depth, actionsLeft, NO_ONE, NO_BOUND, v, NULL);
+    } else {
+        move moves[MAX_LEGAL_MOVES + 1];
+        orderMoves(s, moves, NO_MOVE, actionsLeft);
+        searchMove(s, moves[0], depth, actionsLeft, NO_ONE, NO_BOUND,
+                   v);
+    }
+}
+
+// the outcomes of a chance node and their chances, most likely first
+static int listOutcomes(int isDice, int outcomes[], float chances[]) {
+    int count;
+    if (isDice) {
+        // 7, 6, 8, 5, 9 and so on
+        count = 0;
+        int offset = 0;
+        while (offset <= 5) {
+            int ways = 6 - offset;
+            outcomes[count] = 7 - offset;
+            chances[count] = ways / 36.0f;
+            count++;
+            if (offset > 0) {
+                outcomes[count] = 7 + offset;
+                chances[count] = ways / 36.0f;
+                count++;
+            }
+            offset++;
+        }
+    } else {
+        // two thirds of spinoffs become publications
+        outcomes[0] = OBTAIN_PUBLICATION;
+        chances[0] = 2 / 3.0f;
+        outcomes[1] = OBTAIN_IP_PATENT;
+        chances[1] = 1 / 3.0f;
+        count = NUM_SPINOFF_OUTCOMES;
+    }
+    return count;
+}
+
+static void applyOutcome(Game g, int isDice, int outcome,
+                         undoRecord *undo) {
+    if (isDice) {
+        throwDiceWithUndo(g, outcome, undo);
+    } else {
+        makeActionWithUndo(g, outcome, INVALID_ID, 0, 0, undo);
+    }
+}
+
+static void undoOutcome(Game g, int isDice, const undoRecord *undo) {
+    if (isDice) {
+        unthrowDice(g, undo);
+    } else {
+        unmakeAction(g, undo);
+    }
+}
+
+// every legal move and PASS, best looking first, with first at the
+// front if it is one of them. with no actions left only PASS is.
+// returns how many there are
+static int orderMoves(search *s, move moves[], move first,
+                      int actionsLeft) {
+    int count = 0;
+    if (actionsLeft > 0) {
+        count = generateLegalActions(s->g, moves, MAX_LEGAL_MOVES);
+    }
+    moves[count] = ENCODE_MOVE(PASS, 0);
+    count++;
+
+    float scores[MAX_LEGAL_MOVES + 1];
+    int i = 0;
+    while (i < count) {
+        move m = moves[i];
+        float score = moveScore(s, m);
+        if (m == first) {
+            score = 1e9f;
+        }
+        // insertion sort, which keeps ties in generated order
+        int j = i;
+        while (j > 0 && scores[j-1] < score) {
+            moves[j] = moves[j-1];
+            scores[j] = scores[j-1];
+            j--;
+        }
+        moves[j] = m;
+        scores[j] = score;
+        i++;
+    }
+    return count;
+}
+
+// a guess at how good a move is without playing it: GO8s, campuses
+// on the best land, spinoffs and ARCs, then passing, and retraining
+// last
+static float moveScore(search *s, move m) {
+    float score = 0;
+    int actionCode = MOVE_CODE(m);
+    if (actionCode == BUILD_GO8) {
+        score = 500 + getVertexYield(s->board, MOVE_TARGET(m));
+    } else if (actionCode == BUILD_CAMPUS) {
+        score = 400 + getVertexYield(s->board, MOVE_TARGET(m));
+    } else if (actionCode == START_SPINOFF) {
+        score = 300;
+    } else if (actionCode == OBTAIN_ARC) {
+        score = 200;
+    } else if (actionCode == PASS) {
+        score = 100;
+    }
+    return score;
+}
+
+// the table stores values relative to the player to move, see
+// getCanonicalHash(), so they are rotated on the way in and out.
+// an entry's weight is the turns it was searched for, and it is used
+// if that is at least depth. the key already fixes the actions left
+static int lookUp(search *s, uint64_t key, int depth, int bound,
+                  float alpha, float v[NUM_UNIS], int *exact) {
+    int found = FALSE;
+    ttEntry entry;
+    if (s->table != NULL && probeTransTable(s->table, key, &entry) &&
+            entry.weight >= depth) {
+        int mover = getWhoseTurn(s->g);
+        if (entry.bound == TT_EXACT) {
+            *exact = TRUE;
+            found = TRUE;
+        } else if (entry.bound == TT_UPPER && bound == mover &&
+                entry.value[0] <= alpha) {
+            *exact = FALSE;
+            found = TRUE;
+        }
+        if (found) {
+            int seat = 0;
+            while (seat < NUM_UNIS) {
+                v[(mover - 1 + seat) % NUM_UNIS] = entry.value[seat];
+                seat++;
+            }
+            s->tableHits++;
+        }
+    }
+    return found;
+}
+
+static void storeResult(search *s, uint64_t key, int depth, int bound,
+                        const float v[NUM_UNIS], int exact) {
+    int mover = getWhoseTurn(s->g);
+    // a bound on someone else's value is no use to the player to move
+    if (s->table != NULL && (exact || bound == mover)) {
+        ttEntry entry;
+        int seat = 0;
+        while (seat < NUM_UNIS) {
+            entry.value[seat] = v[(mover - 1 + seat) % NUM_UNIS];
+            seat++;
+        }
+        entry.weight = depth;
+        entry.bound = TT_EXACT;
+        if (!exact) {
+            entry.bound = TT_UPPER;
+        }
+        storeTransTable(s->table, key, &entry);
+    }
+}
+
+// each university's share of the total score
+static void evaluate(search *s, float v[NUM_UNIS]) {
+    Game g = s->g;
+    float score[NUM_UNIS];
+    float total = 0;
+    int uni = UNI_A;
+    while (uni <= UNI_C) {
+        score[uni-1] = BASE_SCORE + getKPIpoints(g, uni);
+        float bestSite = 0;
+        uint64_t sites = getCampusFrontier(g, uni);
+        while (sites != 0) {
+            float yield = getVertexYield(s->board,
+                                         __builtin_ctzll(sites));
+            if (yield > bestSite) {
+                bestSite = yield;
+            }
+            sites &= sites - 1;
+        }
+        score[uni-1] += SITE_WEIGHT * bestSite;
+        int discipline = STUDENT_BPS;
+        while (discipline <= STUDENT_MMONEY) {
+            score[uni-1] += STUDENT_WEIGHT *
+                    getStudents(g, uni, discipline);
+            discipline++;
+        }
+        uni++;
+    }
+    int vertex = 0;
+    while (vertex < NUM_VERTICES) {
+        int contents = getCampusAt(g, vertex);
+        if (contents != VACANT_VERTEX) {
+            float production = PRODUCTION_WEIGHT *
+                    getVertexYield(s->board, vertex);
+            if (contents > NUM_UNIS) {
+                contents -= NUM_UNIS;
+                production *= 2;
+            }
+            score[contents-1] += production;
+        }
+        vertex++;
+    }
+    uni = 0;
+    while (uni < NUM_UNIS) {
+        total += score[uni];
+        uni++;
+    }
+    uni = 0;
+    while (uni < NUM_UNIS) {
+        v[uni] = score[uni] / total;
+        uni++;
+    }
+}
+
+// the first university to WINNING_KPI wins, as in runGame
+static int findWinner(Game g) {
+    int winner = NO_ONE;
+    int uni = UNI_A;
+    while (uni <= UNI_C) {
+        if (getKPIpoints(g, uni) >= WINNING_KPI) {
+            winner = uni;
+        }
+        uni++;
+    }
+    return winner;
+}
+
+// values for a search that failed low: bound gets upper and the
+// others split the rest, which is never looked at
+static void failLow(int bound, float upper, float v[NUM_UNIS]) {
+    int uni = UNI_A;
+    while (uni <= UNI_C) {
+        v[uni-1] = (1 - upper) / (NUM_UNIS - 1);
+        uni++;
+    }
+    if (bound != NO_ONE) {
+        v[bound-1] = upper;
+    }
+}
+
+// TRUE once the search has to stop. everything after that is thrown
+// away, so it only has to end quickly
+static int outOfBudget(search *s) {
+    if (s->canStop && !s->stopped) {
+        if (s->nodeLimit > 0 && s->nodes >= s->nodeLimit) {
+            s->stopped = TRUE;
+        } else if (s->deadline > 0 && s->nodes % CLOCK_INTERVAL == 0 &&
+                secondsNow() >= s->deadline) {
+            s->stopped = TRUE;
+        }
+    }
+    return s->stopped;
+}
+
+static double secondsNow(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+// vim: sts=4 et cc=72
@@ -0,0 +1,74 @@
+/*
+ * expectimax.h
+ * A depth limited expectimax AI for Knowledge Island
+ *
+ * Copyright 2015 Simon Shields, Harrison Shoebridge, Julian Tu and James Ye
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * decideActionExpectimax() looks at every dice roll and spinoff
+ * outcome up to a fixed number of turns ahead, with each university
+ * maximising its own share of a heuristic score (max^n). Search
+ * deepens one turn at a time until the budget runs out. Like
+ * mcts.c, compile expectimax.c with -DEXPECTIMAX_DECIDE_ACTION and
+ * leave out mechanicalTurk.c to use it as decideAction() instead.
+ * Include Game.h before this file.
+ *
+ */
+
+#ifndef EXPECTIMAX_H
+#define EXPECTIMAX_H
+
+#include <stddef.h>
+
+typedef struct _expectimaxConfig {
+    int maxDepth;            // turns to look ahead at most
+    int maxTurnActions;      // actions searched in a turn before PASS
+    long nodeBudget;         // stop deepening after this many nodes
+    int timeBudgetMs;        // or after this long, 0 for no limit
+    size_t tableBytes;       // transposition table size, 0 for none
+    int keepTable;           // carry the table over to the next
+                             // decision instead of clearing it
+    int verbose;             // print the search depth every decision
+} expectimaxConfig;
+
+typedef struct _expectimaxStats {
+    int depth;               // turns searched by the deepest search
+                             // that finished
+    long nodes;
+    long tableHits;
+    double seconds;
+} expectimaxStats;
+
+// the settings used until setExpectimaxConfig() is called. with only
+// a node budget and no keepTable the AI always makes the same choice
+// in the same position, whatever it searched before. a time budget
+// trades that for a bounded time per move, and keepTable for what
+// earlier searches found. settings, stats and the table belong to
+// the calling thread, so each thread running decideActionExpectimax()
+// sets its own
+void getDefaultExpectimaxConfig(expectimaxConfig *config);
+void setExpectimaxConfig(const expectimaxConfig *config);
+
+// searches from g, which must be the current player's turn, and
+// returns the best action found by the deepest search that finished.
+// START_SPINOFF is returned as is for the caller to resolve
+action decideActionExpectimax(Game g);
+
+// how the last decideActionExpectimax() call went
+expectimaxStats getLastExpectimaxStats(void);
+
+// frees the calling thread's transposition table
+void disposeExpectimax(void);
+
+#endif
@@ -0,0 +1,684 @@
+/*
+ * mcts.c
+ * A Monte Carlo tree search AI for Knowledge Island
+ *
+ * Copyright 2015 Simon Shields, Harrison Shoebridge, Julian Tu and James Ye
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+#include <time.h>
+#include <pthread.h>
+#include <stdint.h>
+#include "Game.h"
+#include "GameExt.h"
+#include "mcts.h"
+
+#define WINNING_KPI 150
+
+#define MIN_DICE_VALUE 2
+#define MAX_DICE_VALUE 12
+#define NUM_DICE_VALUES (MAX_DICE_VALUE - MIN_DICE_VALUE + 1)
+#define NUM_SPINOFF_OUTCOMES 2
+
+#define DEFAULT_ITERATIONS 2000
+#define DEFAULT_EXPLORATION 0.7
+#define DEFAULT_MAX_NODES (1 << 18)
+#define DEFAULT_ROLLOUT_TURNS 300
+#define DEFAULT_VIRTUAL_LOSS 3
+
+// the deepest the tree walk goes in one iteration
+#define MAX_TREE_DEPTH 1024
+// how many iterations run between looks at the clock
+#define CLOCK_INTERVAL 32
+
+// rollouts build when they can, and only retrain some of the time
+#define ROLLOUT_BUILD_PERCENT 85
+#define ROLLOUT_RETRAIN_PERCENT 25
+
+// a decision node is a position where the player to move picks a
+// move. PASS and START_SPINOFF lead to chance nodes, whose children
+// are the dice rolls or the two ways a spinoff can turn out
+#define NODE_DECISION 0
+#define NODE_CHANCE 1
+#define NOT_EXPANDED -1
+#define EXPANDING -2
+
+// nodes are shared between threads in tree parallel mode, so every
+// field that changes after a node is created is only touched with
+// these. the orderings make a node's children visible before its
+// firstChild says they exist
+#define LOAD(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define STORE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define ADD(p, v) __atomic_fetch_add((p), (v), __ATOMIC_RELAXED)
+#define CAS(p, expected, desired) \
+        __atomic_compare_exchange_n((p), (expected), (desired), FALSE, \
+                                    __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+
+typedef struct _mctsNode {
+    int32_t firstChild;       // children are contiguous in the arena
+    int16_t numChildren;
+    uint8_t kind;
+    uint8_t outcome;          // dice score or spinoff outcome
+    move m;                   // the move that led here
+    uint16_t inFlight;        // threads below here right now
+    uint32_t visits;
+    float reward[NUM_UNIS];   // summed over every visit
+} mctsNode;
+
+// a tree and the slice of the arena it grows into. tree parallel
+// threads all share one, root parallel threads have one each
+typedef struct _tree {
+    mctsNode *nodes;
+    int used;
+    int capacity;
+} tree;
+
+// when to stop, shared by every thread in a search
+typedef struct _budget {
+    long claimed;
+    long iterationLimit;
+    double deadline;
+    int stop;
+} budget;
+
+// everything one thread needs to search. the settings are the
+// calling thread's, which its helpers can't see as their own
+typedef struct _search {
+    const mctsConfig *config;
+    tree *t;
+    budget *b;
+    Game root;
+    Game scratch;
+    uint64_t rng;
+    long iterations;
+} search;
+
+// one of each per thread, so games on different threads can each
+// have their own searches
+static __thread mctsConfig config = {
+    0, 0, DEFAULT_EXPLORATION, DEFAULT_MAX_NODES, DEFAULT_ROLLOUT_TURNS,
+    1, FALSE, 1, MCTS_TREE_PARALLEL, DEFAULT_VIRTUAL_LOSS
+};
+static __thread mctsStats lastStats;
+static __thread mctsNode *arena = NULL;
+static __thread int arenaSize = 0;
+
+static void initTree(tree *t, mctsNode *nodes, int capacity);
+static void *searchThread(void *arg);
+static int keepSearching(search *s);
+static int bestRootChild(tree trees[], int numTrees);
+static void runIteration(search *s);
+static int selectChild(search *s, mctsNode *node, int player);
+static int sampleOutcome(search *s, mctsNode *node);
+static int expand(search *s, mctsNode *node, int kind, Game g);
+static int allocateNodes(tree *t, int count);
+static float loadReward(float *total);
+static void addReward(float *total, float reward);
+static void applyEdge(Game g, mctsNode *parent, mctsNode *child);
+static void rollout(search *s, Game g, float reward[NUM_UNIS]);
+static move rolloutMove(search *s, Game g);
+static int findWinner(Game g);
+static void scoreGame(Game g, float reward[NUM_UNIS]);
+static int rollDice(search *s);
+static uint64_t nextRandom(uint64_t *state);
+static int randomBelow(search *s, int n);
+static double secondsNow(void);
+
+void getDefaultMCTSConfig(mctsConfig *c) {
+    c->timeBudgetMs = 0;
+    c->iterationBudget = DEFAULT_ITERATIONS;
+    c->exploration = DEFAULT_EXPLORATION;
+    c->maxNodes = DEFAULT_MAX_NODES;
+    c->rolloutTurnLimit = DEFAULT_ROLLOUT_TURNS;
+    c->seed = 1;
+    c->verbose = FALSE;
+    c->numThreads = 1;
+    c->parallelMode = MCTS_TREE_PARALLEL;
+    c->virtualLoss = DEFAULT_VIRTUAL_LOSS;
+}
+
+void setMCTSConfig(const mctsConfig *c) {
+    config = *c;
+    if (config.numThreads < 1) {
+        config.numThreads = 1;
+    } else if (config.numThreads > MCTS_MAX_THREADS) {
+        config.numThreads = MCTS_MAX_THREADS;
+    }
+}
+
+mctsStats getLastMCTSStats(void) {
+    return lastStats;
+}
+
+void disposeMCTS(void) {
+    free(arena);
+    arena = NULL;
+    arenaSize = 0;
+}
+
+#ifdef MCTS_DECIDE_ACTION
+action decideAction(Game g) {
+    return decideActionMCTS(g);
+}
+#endif
+
+action decideActionMCTS(Game g) {
+    action best = {PASS, "", 0, 0};
+    memset(&lastStats, 0, sizeof(lastStats));
+
+    move moves[MAX_LEGAL_MOVES];
+    if (generateLegalActions(g, moves, MAX_LEGAL_MOVES) > 0) {
+        if (arenaSize != config.maxNodes) {
+            disposeMCTS();
+            arena = malloc(sizeof(mctsNode) * config.maxNodes);
+            assert(arena != NULL);
+            arenaSize = config.maxNodes;
+        }
+
+        int numThreads = config.numThreads;
+        int numTrees = 1;
+        if (config.parallelMode == MCTS_ROOT_PARALLEL) {
+            numTrees = numThreads;
+        }
+        tree trees[MCTS_MAX_THREADS];
+        int slice = arenaSize / numTrees;
+        int i = 0;
+        while (i < numTrees) {
+            initTree(&trees[i], arena + i * slice, slice);
+            i++;
+        }
+
+        budget b;
+        b.claimed = 0;
+        b.iterationLimit = config.iterationBudget;
+        if (b.iterationLimit <= 0 && config.timeBudgetMs <= 0) {
+            b.iterationLimit = DEFAULT_ITERATIONS;
+        }
+        double start = secondsNow();
+        b.deadline = start + config.timeBudgetMs / 1000.0;
+        b.stop = FALSE;
+
+        // every decision gets its own stream, so the same position
+        // on a different turn is searched differently, and every
+        // thread gets its own part of it
+        uint64_t seed = config.seed ^ (getStateHash(g) +
+                                       getTurnNumber(g));
+        search searches[MCTS_MAX_THREADS];
+        i = 0;
+        while (i < numThreads) {
+            searches[i].config = &config;
+            searches[i].t = &trees[i % numTrees];
+            searches[i].b = &b;
+            searches[i].root = g;
+            searches[i].scratch = cloneGame(g);
+            searches[i].rng = seed + i * 0x9E3779B97F4A7C15ULL;
+            nextRandom(&searches[i].rng);
+            searches[i].iterations = 0;
+            i++;
+        }
+
+        // the calling thread does the first share of the work itself
+        pthread_t threads[MCTS_MAX_THREADS];
+        i = 1;
+        while (i < numThreads) {
+            int failed = pthread_create(&threads[i], NULL,
+                                        searchThread, &searches[i]);
+            assert(!failed);
+            i++;
+        }
+        searchThread(&searches[0]);
+        long iterations = searches[0].iterations;
+        i = 1;
+        while (i < numThreads) {
+            pthread_join(threads[i], NULL);
+            iterations += searches[i].iterations;
+            i++;
+        }
+
+        int chosen = bestRootChild(trees, numTrees);
+        if (chosen != NOT_EXPANDED) {
+            best = moveToAction(trees[0].nodes[chosen].m);
+        }
+
+        int nodesUsed = 0;
+        i = 0;
+        while (i < numTrees) {
+            nodesUsed += trees[i].used;
+            i++;
+        }
+        i = 0;
+        while (i < numThreads) {
+            disposeGame(searches[i].scratch);
+            i++;
+        }
+
+        lastStats.iterations = iterations;
+        lastStats.seconds = secondsNow() - start;
+        if (lastStats.seconds > 0) {
+            lastStats.iterationsPerSecond =
+                    iterations / lastStats.seconds;
+        }
+        lastStats.nodesUsed = nodesUsed;
+        lastStats.threads = numThreads;
+        if (config.verbose) {
+            fprintf(stderr, "mcts: %ld iterations in %.3fs "
+                    "(%.0f/s) on %d threads, %d nodes\n", iterations,
+                    lastStats.seconds, lastStats.iterationsPerSecond,
+                    numThreads, nodesUsed);
+        }
+    }
+    return best;
+}
+
+static void initTree(tree *t, mctsNode *nodes, int capacity) {
+    t->nodes = nodes;
+    t->capacity = capacity;
+    t->used = 1;
+    memset(&nodes[0], 0, sizeof(mctsNode));
+    nodes[0].kind = NODE_DECISION;
+    nodes[0].firstChild = NOT_EXPANDED;
+}
+
+// works on a copy on its own stack, so threads don't share cache
+// lines for their random state and counts
+static void *searchThread(void *arg) {
+    search s = *(search *) arg;
+    while (keepSearching(&s)) {
+        runIteration(&s);
+        s.iterations++;
+    }
+    ((search *) arg)->iterations = s.iterations;
+    return NULL;
+}
+
+// claims the next iteration from the budget, if there is one left
+static int keepSearching(search *s) {
+    budget *b = s->b;
+    int keepGoing = !LOAD(&b->stop);
+    if (keepGoing && b->iterationLimit > 0 &&
+            ADD(&b->claimed, 1) >= b->iterationLimit) {
+        keepGoing = FALSE;
+    }
+    if (keepGoing && s->config->timeBudgetMs > 0 &&
+            s->iterations % CLOCK_INTERVAL == 0 &&
+            s->iterations > 0 && secondsNow() >= b->deadline) {
+        keepGoing = FALSE;
+    }
+    if (!keepGoing) {
+        STORE(&b->stop, TRUE);
+    }
+    return keepGoing;
+}
+
+// the most visited move is the most trusted one. root parallel
+// trees all expanded the same root the same way, so their visits
+// are added up child by child. returns the child's index in the
+// first tree, or NOT_EXPANDED if no tree got that far
+static int bestRootChild(tree trees[], int numTrees) {
+    int best = NOT_EXPANDED;
+    uint32_t bestVisits = 0;
+    mctsNode *root = &trees[0].nodes[0];
+    if (root->firstChild >= 0) {
+        int i = 0;
+        while (i < root->numChildren) {
+            uint32_t visits = 0;
+            int t = 0;
+            while (t < numTrees) {
+                mctsNode *r = &trees[t].nodes[0];
+                if (r->firstChild >= 0) {
+                    visits += trees[t].nodes[r->firstChild + i].visits;
+                }
+                t++;
+            }
+            if (best == NOT_EXPANDED || visits > bestVisits) {
+                best = root->firstChild + i;
+                bestVisits = visits;
+            }
+            i++;
+        }
+    }
+    return best;
+}
+
+// one pass of select, expand, roll out and back up. every node on
+// the way down takes a virtual loss, a visit that brings no reward,
+// so other threads are steered elsewhere until the real result is
+// backed up in its place
+static void runIteration(search *s) {
+    mctsNode *nodes = s->t->nodes;
+    int path[MAX_TREE_DEPTH];
+    int depth = 0;
+    Game g = s->scratch;
+    copyGameInto(g, s->root);
+
+    int current = 0;
+    ADD(&nodes[current].inFlight, 1);
+    path[depth] = current;
+    depth++;
+    int leaf = FALSE;
+    while (!leaf && depth < MAX_TREE_DEPTH &&
+            findWinner(g) == NO_ONE) {
+        mctsNode *node = &nodes[current];
+        int wasNew = LOAD(&node->visits) == 0 && current != 0 &&
+                node->kind == NODE_DECISION;
+        int32_t firstChild = LOAD(&node->firstChild);
+        if (firstChild == NOT_EXPANDED) {
+            if (wasNew || !expand(s, node, node->kind, g)) {
+                // a fresh node is rolled out before it grows, and a
+                // full arena stops growing altogether
+                leaf = TRUE;
+            }
+        } else if (firstChild == EXPANDING) {
+            // another thread is growing it, so stop here for now
+            leaf = TRUE;
+        }
+        if (!leaf) {
+            int next;
+            if (node->kind == NODE_DECISION) {
+                next = selectChild(s, node, getWhoseTurn(g));
+            } else {
+                next = sampleOutcome(s, node);
+            }
+            ADD(&nodes[next].inFlight, 1);
+            applyEdge(g, node, &nodes[next]);
+            current = next;
+            path[depth] = current;
+            depth++;
+        }
+    }
+
+    float reward[NUM_UNIS];
+    rollout(s, g, reward);
+
+    int i = 0;
+    while (i < depth) {
+        mctsNode *node = &nodes[path[i]];
+        int uni = 0;
+        while (uni < NUM_UNIS) {
+            addReward(&node->reward[uni], reward[uni]);
+            uni++;
+        }
+        ADD(&node->visits, 1);
+        ADD(&node->inFlight, -1);
+        i++;
+    }
+}
+
+// UCT: the child with the best average for player plus a bonus for
+// being rarely tried. untried children always go first. threads
+// still below a child count as visits that scored nothing
+static int selectChild(search *s, mctsNode *node, int player) {
+    mctsNode *nodes = s->t->nodes;
+    int virtualLoss = s->config->virtualLoss;
+    int firstChild = LOAD(&node->firstChild);
+    int best = firstChild;
+    double bestScore = -1;
+    // this thread is one of those below node, but not a loss yet
+    int others = LOAD(&node->inFlight) - 1;
+    double logVisits = log(LOAD(&node->visits) +
+                           virtualLoss * others + 1);
+    int child = firstChild;
+    while (child < firstChild + node->numChildren) {
+        mctsNode *c = &nodes[child];
+        double visits = LOAD(&c->visits);
+        int inFlight = LOAD(&c->inFlight);
+        double score;
+        if (visits == 0 && inFlight == 0) {
+            // break ties between untried moves at random
+            score = 1e9 + randomBelow(s, 1024);
+        } else {
+            visits += virtualLoss * inFlight;
+            score = loadReward(&c->reward[player-1]) / visits +
+                    s->config->exploration *
+                    sqrt(logVisits / visits);
+        }
+        if (score > bestScore) {
+            bestScore = score;
+            best = child;
+        }
+        child++;
+    }
+    return best;
+}
+
+// picks a dice roll or spinoff outcome with its real probability
+static int sampleOutcome(search *s, mctsNode *node) {
+    int chosen;
+    int firstChild = LOAD(&node->firstChild);
+    if (node->m == ENCODE_MOVE(PASS, 0)) {
+        int roll = rollDice(s);
+        chosen = firstChild + roll - MIN_DICE_VALUE;
+    } else {
+        // two thirds of spinoffs become publications
+        chosen = firstChild;
+        if (randomBelow(s, 3) == 2) {
+            chosen++;
+        }
+    }
+    return chosen;
+}
+
+// gives a node all of its children at once. returns FALSE if
+// another thread got to it first or the arena doesn't have room
+static int expand(search *s, mctsNode *node, int kind, Game g) {
+    int expanded = FALSE;
+    int32_t expected = NOT_EXPANDED;
+    if (CAS(&node->firstChild, &expected, EXPANDING)) {
+        move moves[MAX_LEGAL_MOVES + 1];
+        int count;
+        if (kind == NODE_DECISION) {
+            count = generateLegalActions(g, moves, MAX_LEGAL_MOVES);
+            moves[count] = ENCODE_MOVE(PASS, 0);
+            count++;
+        } else if (node->m == ENCODE_MOVE(PASS, 0)) {
+            count = NUM_DICE_VALUES;
+        } else {
+            count = NUM_SPINOFF_OUTCOMES;
+        }
+
+        int first = allocateNodes(s->t, count);
+        if (first == NOT_EXPANDED) {
+            STORE(&node->firstChild, NOT_EXPANDED);
+        } else {
+            int i = 0;
+            while (i < count) {
+                mctsNode *child = &s->t->nodes[first + i];
+                memset(child, 0, sizeof(mctsNode));
+                child->firstChild = NOT_EXPANDED;
+                child->kind = NODE_DECISION;
+                if (kind == NODE_DECISION) {
+                    child->m = moves[i];
+                    if (MOVE_CODE(moves[i]) == PASS ||
+                            MOVE_CODE(moves[i]) == START_SPINOFF) {
+                        child->kind = NODE_CHANCE;
+                    }
+                } else if (node->m == ENCODE_MOVE(PASS, 0)) {
+                    child->outcome = MIN_DICE_VALUE + i;
+                } else {
+                    child->outcome = i;
+                }
+                i++;
+            }
+            node->numChildren = count;
+            STORE(&node->firstChild, first);
+            expanded = TRUE;
+        }
+    }
+    return expanded;
+}
+
+// takes count nodes from the end of the tree's slice of the arena.
+// returns the first one, or NOT_EXPANDED if there isn't room
+static int allocateNodes(tree *t, int count) {
+    int first = NOT_EXPANDED;
+    int used = LOAD(&t->used);
+    while (first == NOT_EXPANDED && used + count <= t->capacity) {
+        if (CAS(&t->used, &used, used + count)) {
+            first = used;
+        }
+    }
+    return first;
+}
+
+static float loadReward(float *total) {
+    float reward;
+    __atomic_load(total, &reward, __ATOMIC_RELAXED);
+    return reward;
+}
+
+// an atomic += for floats, which the hardware doesn't have
+static void addReward(float *total, float reward) {
+    if (reward != 0) {
+        float old = loadReward(total);
+        float sum = old + reward;
+        while (!__atomic_compare_exchange(total, &old, &sum, FALSE,
+                                          __ATOMIC_RELAXED,
+                                          __ATOMIC_RELAXED)) {
+            sum = old + reward;
+        }
+    }
+}
+
+// plays the move or chance outcome between parent and child
+static void applyEdge(Game g, mctsNode *parent, mctsNode *child) {
+    if (parent->kind == NODE_DECISION) {
+        // a chance node's move waits for its outcome
+        if (child->kind == NODE_DECISION) {
+            makeMove(g, child->m);
+        }
+    } else if (parent->m == ENCODE_MOVE(PASS, 0)) {
+        throwDice(g, child->outcome);
+    } else if (child->outcome == 0) {
+        makeMove(g, ENCODE_MOVE(OBTAIN_PUBLICATION, 0));
+    } else {
+        makeMove(g, ENCODE_MOVE(OBTAIN_IP_PATENT, 0));
+    }
+}
+
+// plays g out with the rollout policy and scores the result
+static void rollout(search *s, Game g, float reward[NUM_UNIS]) {
+    int turns = 0;
+    while (findWinner(g) == NO_ONE &&
+            turns < s->config->rolloutTurnLimit) {
+        move m = rolloutMove(s, g);
+        if (m == ENCODE_MOVE(PASS, 0)) {
+            throwDice(g, rollDice(s));
+            turns++;
+        } else if (MOVE_CODE(m) == START_SPINOFF) {
+            if (randomBelow(s, 3) <= 1) {
+                makeMove(g, ENCODE_MOVE(OBTAIN_PUBLICATION, 0));
+            } else {
+                makeMove(g, ENCODE_MOVE(OBTAIN_IP_PATENT, 0));
+            }
+        } else {
+            makeMove(g, m);
+        }
+    }
+    scoreGame(g, reward);
+}
+
+// a cheap random policy: usually build something if possible,
+// sometimes retrain, otherwise pass
+static move rolloutMove(search *s, Game g) {
+    move moves[MAX_LEGAL_MOVES];
+    int count = generateLegalActions(g, moves, MAX_LEGAL_MOVES);
+    int builds = 0;
+    while (builds < count &&
+            MOVE_CODE(moves[builds]) != RETRAIN_STUDENTS) {
+        builds++;
+    }
+    // retrains always come last
+    int retrains = count - builds;
+
+    move chosen = ENCODE_MOVE(PASS, 0);
+    if (builds > 0 && randomBelow(s, 100) < ROLLOUT_BUILD_PERCENT) {
+        chosen = moves[randomBelow(s, builds)];
+    } else if (retrains > 0 &&
+            randomBelow(s, 100) < ROLLOUT_RETRAIN_PERCENT) {
+        chosen = moves[builds + randomBelow(s, retrains)];
+    }
+    return chosen;
+}
+
+// the first university to WINNING_KPI wins, as in runGame
+static int findWinner(Game g) {
+    int winner = NO_ONE;
+    int uni = UNI_A;
+    while (uni <= UNI_C) {
+        if (getKPIpoints(g, uni) >= WINNING_KPI) {
+            winner = uni;
+        }
+        uni++;
+    }
+    return winner;
+}
+
+// 1 for the winner, or each university's share of the KPIs if the
+// rollout ran out of turns
+static void scoreGame(Game g, float reward[NUM_UNIS]) {
+    int winner = findWinner(g);
+    int total = 0;
+    int uni = UNI_A;
+    while (uni <= UNI_C) {
+        total += getKPIpoints(g, uni);
+        uni++;
+    }
+    uni = UNI_A;
+    while (uni <= UNI_C) {
+        if (winner != NO_ONE) {
+            reward[uni-1] = (uni == winner);
+        } else if (total > 0) {
+            reward[uni-1] = (float) getKPIpoints(g, uni) / total;
+        } else {
+            reward[uni-1] = 1.0f / NUM_UNIS;
+        }
+        uni++;
+    }
+}
+
+static int rollDice(search *s) {
+    return 2 + randomBelow(s, 6) + randomBelow(s, 6);
+}
+
+// xorshift64*, which is plenty for rollouts and keeps the search off
+// rand() so it doesn't disturb the dice in runGame
+static uint64_t nextRandom(uint64_t *state) {
+    uint64_t x = *state;
+    if (x == 0) {
+        x = 0x9E3779B97F4A7C15ULL;
+    }
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+static int randomBelow(search *s, int n) {
+    return (int) ((nextRandom(&s->rng) >> 32) % n);
+}
+
+static double secondsNow(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+// vim: sts=4 et cc=72
@@ -0,0 +1,82 @@
+/*
+ * mcts.h
+ * A Monte Carlo tree search AI for Knowledge Island
+ *
+ * Copyright 2015 Simon Shields, Harrison Shoebridge, Julian Tu and James Ye
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * decideActionMCTS() can sit next to mechanicalTurk's decideAction()
+ * in the same program. Compile mcts.c with -DMCTS_DECIDE_ACTION and
+ * leave out mechanicalTurk.c to use it as decideAction() instead.
+ * Link with -pthread.
+ * Include Game.h before this file.
+ *
+ */
+
+#ifndef MCTS_H
+#define MCTS_H
+
+#include <stdint.h>
+
+#define MCTS_MAX_THREADS 64
+
+// tree parallel threads all grow one shared tree. root parallel
+// threads each grow their own in a slice of the arena, and the root
+// visits are added together at the end
+#define MCTS_TREE_PARALLEL 0
+#define MCTS_ROOT_PARALLEL 1
+
+typedef struct _mctsConfig {
+    int timeBudgetMs;        // think for this long, 0 for no limit
+    int iterationBudget;     // or this many iterations, 0 for no limit
+    double exploration;      // the UCT exploration constant
+    int maxNodes;            // size of the preallocated node arena
+    int rolloutTurnLimit;    // score a rollout by KPI after this many
+                             // turns without a winner
+    uint64_t seed;           // the search is repeatable for a seed
+                             // when it runs on one thread
+    int verbose;             // print iterations/second every decision
+    int numThreads;          // 1 searches on the calling thread only
+    int parallelMode;        // MCTS_TREE_PARALLEL or MCTS_ROOT_PARALLEL
+    int virtualLoss;         // visits a tree parallel thread charges
+                             // each node it is still below
+} mctsConfig;
+
+typedef struct _mctsStats {
+    long iterations;
+    double seconds;
+    double iterationsPerSecond;
+    int nodesUsed;
+    int threads;
+} mctsStats;
+
+// the settings used until setMCTSConfig() is called. if both budgets
+// are 0 the default iteration budget is used. settings, stats and
+// the node arena belong to the calling thread, so each thread running
+// decideActionMCTS() sets its own
+void getDefaultMCTSConfig(mctsConfig *config);
+void setMCTSConfig(const mctsConfig *config);
+
+// searches from g, which must be the current player's turn, and
+// returns the move it visited most. START_SPINOFF is returned as is
+// for the caller to resolve, like decideAction()
+action decideActionMCTS(Game g);
+
+// how the last decideActionMCTS() call went
+mctsStats getLastMCTSStats(void);
+
+// frees the node arena. the next search allocates it again
+void disposeMCTS(void);
+
+#endif
@@ -0,0 +1,100 @@
+/*
+ * retrainPlanner.c
+ * Finds the cheapest retraining that pays for a build
+ *
+ * Copyright 2015 Simon Shields, Harrison Shoebridge, Julian Tu and James Ye
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "Game.h"
+#include "GameExt.h"
+#include "retrainPlanner.h"
+
+static int cheaperSource(int a, int b, const int rate[],
+                         const int spare[]);
+
+int planRetrain(Game g, int player, const int targetCost[],
+                move plan[], int cap) {
+    int rate[NUM_DISCIPLINES];
+    int spare[NUM_DISCIPLINES];
+    int needed[NUM_DISCIPLINES];
+    int order[NUM_DISCIPLINES];
+    int totalNeeded = 0;
+    int totalSupply = 0;
+    int d = STUDENT_THD;
+    while (d <= STUDENT_MMONEY) {
+        rate[d] = getExchangeRate(g, player, d, d);
+        int left = getStudents(g, player, d) - targetCost[d];
+        needed[d] = 0;
+        spare[d] = 0;
+        if (left < 0) {
+            needed[d] = -left;
+            totalNeeded -= left;
+        } else if (d != STUDENT_THD) {
+            // THD can be retrained into but never from
+            spare[d] = left / rate[d];
+            totalSupply += spare[d];
+        }
+
+        // insertion sort, cheapest source first
+        int i = d;
+        while (i > 0 && cheaperSource(d, order[i - 1], rate, spare)) {
+            order[i] = order[i - 1];
+            i--;
+        }
+        order[i] = d;
+        d++;
+    }
+
+    int count = totalNeeded;
+    if (totalNeeded > totalSupply ||
+            (totalNeeded > 0 && getTurnNumber(g) == -1)) {
+        count = RETRAIN_INFEASIBLE;
+    } else {
+        // every source has students to spare and nothing is retrained
+        // into one, so the moves stay legal in this order
+        int written = 0;
+        int source = 0;
+        int to = STUDENT_THD;
+        while (to <= STUDENT_MMONEY && written < cap) {
+            while (needed[to] > 0 && written < cap) {
+                while (spare[order[source]] == 0) {
+                    source++;
+                }
+                plan[written] = ENCODE_RETRAIN(order[source], to);
+                spare[order[source]]--;
+                needed[to]--;
+                written++;
+            }
+            to++;
+        }
+    }
+    return count;
+}
+
+// TRUE if discipline a should be spent before b: a lower exchange
+// rate, then more to spare
+static int cheaperSource(int a, int b, const int rate[],
+                         const int spare[]) {
+    int cheaper;
+    if (rate[a] != rate[b]) {
+        cheaper = rate[a] < rate[b];
+    } else {
+        cheaper = spare[a] > spare[b];
+    }
+    return cheaper;
+}
+
+// vim: sts=4 et cc=72
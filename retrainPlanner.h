@@ -0,0 +1,51 @@
+/*
+ * retrainPlanner.h
+ * Finds the cheapest retraining that pays for a build
+ *
+ * Copyright 2015 Simon Shields, Harrison Shoebridge, Julian Tu and James Ye
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * A retraining's price only depends on the discipline the students
+ * come from, so every student short of a build costs the same
+ * whichever discipline it's for, and the cheapest way to cover them
+ * all is to keep taking the cheapest source that has students to
+ * spare. planRetrain() does that with no allocation and a few dozen
+ * comparisons, so searches can call it at every node. Include
+ * Game.h and GameExt.h before this file.
+ *
+ */
+
+#ifndef RETRAIN_PLANNER_H
+#define RETRAIN_PLANNER_H
+
+// returned by planRetrain() when no retraining affords the build
+#define RETRAIN_INFEASIBLE -1
+
+// the costs of the builds, indexed by discipline, for targetCost
+#define CAMPUS_COST {0, 1, 1, 1, 1, 0}
+#define GO8_COST {0, 0, 0, 2, 0, 3}
+#define ARC_COST {0, 1, 1, 0, 0, 0}
+#define SPINOFF_COST {0, 0, 0, 1, 1, 1}
+
+// finds the RETRAIN_STUDENTS moves that leave player with at least
+// targetCost[d] students of each discipline d while spending as few
+// students as possible. at most cap moves are written to plan, in an
+// order they can be made in, and the number of moves needed is
+// returned, or RETRAIN_INFEASIBLE if the build can't be afforded.
+// 0 means the player can afford it already. only BPS to MMONEY are
+// retrained from, and ties go to whichever has the most to spare
+int planRetrain(Game g, int player, const int targetCost[],
+                move plan[], int cap);
+
+#endif
@@ -0,0 +1,136 @@
+/*
+ * rng.c
+ * A counter based random number generator for Knowledge Island
+ *
+ * Copyright 2015 Simon Shields, Harrison Shoebridge, Julian Tu and James Ye
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <stdint.h>
+#include "Game.h"
+#include "rng.h"
+
+#define PHILOX_ROUNDS 10
+#define PHILOX_M0 0xD2511F53
+#define PHILOX_M1 0xCD9E8D57
+#define PHILOX_W0 0x9E3779B9
+#define PHILOX_W1 0xBB67AE85
+
+#define DIE_FACES 6
+
+static void philox(const uint32_t key[2], const uint32_t counter[4],
+                   uint32_t out[4]);
+static void nextBlock(rng *r);
+
+void seedRng(rng *r, uint64_t seed, uint64_t stream) {
+    r->key[0] = (uint32_t) seed;
+    r->key[1] = (uint32_t) (seed >> 32);
+    r->counter[2] = (uint32_t) stream;
+    r->counter[3] = (uint32_t) (stream >> 32);
+    seekRng(r, 0);
+}
+
+void seedGameRng(rng *r, uint64_t seed, uint64_t gameIndex,
+                 int whichStream) {
+    seedRng(r, seed, gameIndex * NUM_GAME_STREAMS + whichStream);
+}
+
+void seekRng(rng *r, uint64_t position) {
+    uint64_t blockIndex = position / RNG_BLOCK_WORDS;
+    r->counter[0] = (uint32_t) blockIndex;
+    r->counter[1] = (uint32_t) (blockIndex >> 32);
+    philox(r->key, r->counter, r->block);
+    r->used = position % RNG_BLOCK_WORDS;
+}
+
+uint32_t nextRng(rng *r) {
+    if (r->used == RNG_BLOCK_WORDS) {
+        nextBlock(r);
+    }
+    uint32_t bits = r->block[r->used];
+    r->used++;
+    return bits;
+}
+
+// Lemire's multiply and shift, drawing again in the rare case that
+// would make some numbers more likely than others
+int rngBelow(rng *r, int bound) {
+    uint32_t range = bound;
+    uint64_t product = (uint64_t) nextRng(r) * range;
+    uint32_t low = (uint32_t) product;
+    if (low < range) {
+        uint32_t threshold = -range % range;
+        while (low < threshold) {
+            product = (uint64_t) nextRng(r) * range;
+            low = (uint32_t) product;
+        }
+    }
+    return (int) (product >> 32);
+}
+
+int rollDiceRng(rng *r) {
+    return rngBelow(r, DIE_FACES) + rngBelow(r, DIE_FACES) + 2;
+}
+
+void generateDiceScores(rng *r, int scores[], int count) {
+    int i = 0;
+    while (i < count) {
+        scores[i] = rollDiceRng(r);
+        i++;
+    }
+}
+
+int isPublicationRng(rng *r) {
+    return rngBelow(r, 3) <= 1;
+}
+
+// the ten rounds of Philox4x32, each a pair of 32 by 32 bit
+// multiplies with the key added in, bumping the key between rounds
+static void philox(const uint32_t key[2], const uint32_t counter[4],
+                   uint32_t out[4]) {
+    uint32_t k0 = key[0];
+    uint32_t k1 = key[1];
+    uint32_t c0 = counter[0];
+    uint32_t c1 = counter[1];
+    uint32_t c2 = counter[2];
+    uint32_t c3 = counter[3];
+    int round = 0;
+    while (round < PHILOX_ROUNDS) {
+        uint64_t product0 = (uint64_t) PHILOX_M0 * c0;
+        uint64_t product1 = (uint64_t) PHILOX_M1 * c2;
+        c0 = (uint32_t) (product1 >> 32) ^ c1 ^ k0;
+        c1 = (uint32_t) product1;
+        c2 = (uint32_t) (product0 >> 32) ^ c3 ^ k1;
+        c3 = (uint32_t) product0;
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+        round++;
+    }
+    out[0] = c0;
+    out[1] = c1;
+    out[2] = c2;
+    out[3] = c3;
+}
+
+static void nextBlock(rng *r) {
+    r->counter[0]++;
+    if (r->counter[0] == 0) {
+        r->counter[1]++;
+    }
+    philox(r->key, r->counter, r->block);
+    r->used = 0;
+}
+
+// vim: sts=4 et cc=72
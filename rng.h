@@ -0,0 +1,78 @@
+/*
+ * rng.h
+ * A counter based random number generator for Knowledge Island
+ *
+ * Copyright 2015 Simon Shields, Harrison Shoebridge, Julian Tu and James Ye
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy as
+ * 1, 2, 3") turns a key and a 128 bit counter into 128 random bits
+ * with no other state. The key is a master seed and the top half of
+ * the counter picks a stream, so every stream is independent of the
+ * others and any point in one can be jumped to at once. An rng is a
+ * small struct with no hidden globals, so each thread or game can
+ * have its own. Include Game.h before this file.
+ *
+ */
+
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+
+// the streams a game draws from, kept apart so that how many
+// spinoffs are started can't change the dice and so on
+#define STREAM_DICE 0
+#define STREAM_SPINOFF 1
+#define STREAM_BOARD 2
+#define NUM_GAME_STREAMS 3
+
+#define RNG_BLOCK_WORDS 4
+
+typedef struct _rng {
+    uint32_t key[2];
+    uint32_t counter[4];
+    uint32_t block[RNG_BLOCK_WORDS];
+    int used;            // words of block already handed out
+} rng;
+
+// starts r at the beginning of a stream
+void seedRng(rng *r, uint64_t seed, uint64_t stream);
+
+// stream of a game: one of the STREAM_* streams of game gameIndex
+void seedGameRng(rng *r, uint64_t seed, uint64_t gameIndex,
+                 int whichStream);
+
+// moves r to the position'th 32 bit number of its stream
+void seekRng(rng *r, uint64_t position);
+
+// the next 32 random bits
+uint32_t nextRng(rng *r);
+
+// a number from 0 to bound - 1, each equally likely. bound must be
+// more than 0
+int rngBelow(rng *r, int bound);
+
+// the total of two six sided dice
+int rollDiceRng(rng *r);
+
+// fills scores with count rolls of two dice, the same as calling
+// rollDiceRng() count times, so a game's dice can be made up front
+void generateDiceScores(rng *r, int scores[], int count);
+
+// TRUE two thirds of the time: a spinoff that ends in a publication
+// rather than a patent
+int isPublicationRng(rng *r);
+
+#endif
@@ -0,0 +1,216 @@
+/*
+ * testRetrainPlanner.c
+ * Checks planRetrain() against the rules and a brute force search
+ *
+ * Copyright 2015 Simon Shields, Harrison Shoebridge, Julian Tu and James Ye
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Must compile with Game.c, boardTopology.c and retrainPlanner.c.
+ * Plays random games on boards that are mostly THD, so players soon
+ * hold far more THD than anything else, and at every turn checks
+ * that each plan is made of legal moves, reaches its target and
+ * spends no more than the cheapest legal sequence of retrains.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "Game.h"
+#include "GameExt.h"
+#include "retrainPlanner.h"
+
+#define NUM_GAMES 40
+#define TURNS_PER_GAME 60
+#define TARGETS_PER_TURN 8
+#define MAX_PLAN 32
+
+// brute force only looks this many retrains past the fewest needed
+#define MAX_BRUTE_NEEDED 2
+#define NO_PLAN 9000
+
+static void makeBoard(int disciplines[], int dice[]);
+static int rollDice(void);
+static void checkTurn(Game g);
+static void checkThdOnlyTarget(Game g, int player);
+static void checkPlan(Game g, int player, const int target[]);
+static int cheapestSpend(int students[], const int rate[],
+                         const int target[], int depth);
+
+int main(int argc, char *argv[]) {
+    srand(1917);
+    int disciplines[NUM_REGIONS];
+    int dice[NUM_REGIONS];
+    int game = 0;
+    while (game < NUM_GAMES) {
+        makeBoard(disciplines, dice);
+        Game g = newGame(disciplines, dice);
+        int turn = 0;
+        while (turn < TURNS_PER_GAME) {
+            throwDice(g, rollDice());
+            checkTurn(g);
+            turn++;
+        }
+        disposeGame(g);
+        game++;
+    }
+    printf("All tests passed, you are Awesome!\n");
+    return EXIT_SUCCESS;
+}
+
+// three quarters THD, the rest anything else
+static void makeBoard(int disciplines[], int dice[]) {
+    int region = 0;
+    while (region < NUM_REGIONS) {
+        disciplines[region] = STUDENT_THD;
+        if (rand() % 4 == 0) {
+            disciplines[region] = STUDENT_BPS + rand() % 5;
+        }
+        dice[region] = rollDice();
+        region++;
+    }
+}
+
+static int rollDice(void) {
+    return rand() % 6 + rand() % 6 + 2;
+}
+
+static void checkTurn(Game g) {
+    int player = getWhoseTurn(g);
+    checkThdOnlyTarget(g, player);
+    int i = 0;
+    while (i < TARGETS_PER_TURN) {
+        int target[NUM_DISCIPLINES];
+        int d = STUDENT_THD;
+        while (d <= STUDENT_MMONEY) {
+            target[d] = getStudents(g, player, d) + rand() % 5 - 2;
+            if (target[d] < 0) {
+                target[d] = 0;
+            }
+            d++;
+        }
+        // builds never need THD, so it's usually all spare, but it
+        // can still be asked for
+        if (rand() % 4 != 0) {
+            target[STUDENT_THD] = 0;
+        }
+        checkPlan(g, player, target);
+        i++;
+    }
+}
+
+// with nothing else to spare, only THD could pay for one more MJ, and
+// THD can't be retrained from
+static void checkThdOnlyTarget(Game g, int player) {
+    int target[NUM_DISCIPLINES];
+    int d = STUDENT_THD;
+    while (d <= STUDENT_MMONEY) {
+        target[d] = getStudents(g, player, d);
+        d++;
+    }
+    target[STUDENT_THD] = 0;
+    target[STUDENT_MJ]++;
+    move plan[MAX_PLAN];
+    assert(planRetrain(g, player, target, plan, MAX_PLAN) ==
+            RETRAIN_INFEASIBLE);
+    checkPlan(g, player, target);
+}
+
+static void checkPlan(Game g, int player, const int target[]) {
+    int students[NUM_DISCIPLINES];
+    int rate[NUM_DISCIPLINES];
+    int totalNeeded = 0;
+    int d = STUDENT_THD;
+    while (d <= STUDENT_MMONEY) {
+        students[d] = getStudents(g, player, d);
+        rate[d] = getExchangeRate(g, player, d, d);
+        if (target[d] > students[d]) {
+            totalNeeded += target[d] - students[d];
+        }
+        d++;
+    }
+
+    move plan[MAX_PLAN];
+    int count = planRetrain(g, player, target, plan, MAX_PLAN);
+    int brute = NO_PLAN;
+    if (totalNeeded <= MAX_BRUTE_NEEDED) {
+        brute = cheapestSpend(students, rate, target,
+                totalNeeded + 1);
+    }
+
+    if (count == RETRAIN_INFEASIBLE) {
+        assert(totalNeeded > MAX_BRUTE_NEEDED || brute == NO_PLAN);
+    } else {
+        assert(count == totalNeeded && count <= MAX_PLAN);
+        Game copy = cloneGame(g);
+        int spent = 0;
+        int i = 0;
+        while (i < count) {
+            action a = {RETRAIN_STUDENTS, "", MOVE_FROM(plan[i]),
+                    MOVE_TO(plan[i])};
+            assert(a.disciplineFrom != STUDENT_THD);
+            assert(isLegalAction(copy, a));
+            spent += getExchangeRate(copy, player, a.disciplineFrom,
+                    a.disciplineTo);
+            makeAction(copy, a);
+            i++;
+        }
+        d = STUDENT_THD;
+        while (d <= STUDENT_MMONEY) {
+            assert(getStudents(copy, player, d) >= target[d]);
+            d++;
+        }
+        assert(totalNeeded > MAX_BRUTE_NEEDED || spent == brute);
+        disposeGame(copy);
+    }
+}
+
+// the fewest students any sequence of at most depth legal retrains
+// can spend to reach target from students, or NO_PLAN
+static int cheapestSpend(int students[], const int rate[],
+                         const int target[], int depth) {
+    int best = 0;
+    int d = STUDENT_THD;
+    while (d <= STUDENT_MMONEY && best == 0) {
+        if (students[d] < target[d]) {
+            best = NO_PLAN;
+        }
+        d++;
+    }
+    if (best == NO_PLAN && depth > 0) {
+        int from = STUDENT_BPS;
+        while (from <= STUDENT_MMONEY) {
+            int to = STUDENT_THD;
+            while (to <= STUDENT_MMONEY &&
+                    students[from] >= rate[from]) {
+                if (to != from) {
+                    students[from] -= rate[from];
+                    students[to]++;
+                    int rest = cheapestSpend(students, rate, target,
+                            depth - 1);
+                    if (rest != NO_PLAN && rest + rate[from] < best) {
+                        best = rest + rate[from];
+                    }
+                    students[to]--;
+                    students[from] += rate[from];
+                }
+                to++;
+            }
+            from++;
+        }
+    }
+    return best;
+}
+
+// vim: sts=4 et cc=72
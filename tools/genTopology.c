@@ -0,0 +1,740 @@
+/*
+ * genTopology.c
+ * Works out the board topology tables and prints them as C source
+ *
+ * Copyright 2015 Simon Shields, Harrison Shoebridge, Julian Tu and James Ye
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * The tables in boardTopologyTables.h are generated by this program
+ * rather than built when the game starts. To regenerate them, from
+ * the top of the repository:
+ *
+ *     gcc -std=gnu99 -I. -o genTopology tools/genTopology.c
+ *     ./genTopology > boardTopologyTables.h
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdint.h>
+#include "Game.h"
+#include "GameExt.h"
+
+// only the constants and types, the tables are defined here
+#define GENERATING_TOPOLOGY
+#include "boardTopology.h"
+
+// most numbers printed on one line of a table
+#define VALUES_PER_LINE 12
+
+static int vertexIds[MAP_VERTEX_HEIGHT][MAP_VERTEX_WIDTH];
+static int arcIds[MAP_ARC_HEIGHT][MAP_ARC_WIDTH];
+static coord vertexCoords[NUM_VERTICES];
+static coord arcCoords[NUM_ARCS];
+static int regionIds[MAP_REGION_HEIGHT][MAP_REGION_WIDTH];
+static int vertexRegions[NUM_VERTICES][MAX_VERTEX_REGIONS];
+static uint64_t vertexNeighbours[NUM_VERTICES];
+static arcSet vertexArcs[NUM_VERTICES];
+static arcSet arcNeighbours[NUM_ARCS];
+static uint64_t arcEnds[NUM_ARCS];
+static int vertexRetrainDiscipline[NUM_VERTICES];
+
+static const int headingDx[NUM_HEADINGS] = {0, 0, -1, 1};
+static const int headingDy[NUM_HEADINGS] = {-1, 1, 0, 0};
+static int pathTransitions[NUM_PATH_STATES][NUM_STEP_CLASSES];
+static int stepClasses[256];
+static int pathStateVertex[NUM_PATH_STATES];
+static int pathStateArc[NUM_PATH_STATES];
+static char vertexPaths[NUM_VERTICES][PATH_LIMIT];
+static char arcPaths[NUM_ARCS][PATH_LIMIT];
+
+static int isValidRegion(int x, int y);
+static int isValidVertex(int x, int y);
+static int isValidARC(int x, int y);
+static void buildTopology(void);
+static void buildRetrainCentres(void);
+static void buildPathDecoder(void);
+static coord stepFrom(coord cur, coord prev, int stepClass);
+static void buildShortestPaths(void);
+static void printValues(const int *values, int n, const char *indent);
+static void printTable(const char *declaration, const int *values,
+        int n);
+static void printGrid(const char *declaration, const int *values,
+        int rows, int columns);
+static void printCoords(const char *declaration, const coord *coords,
+        int n);
+static void printMasks(const char *declaration, const uint64_t *masks,
+        int n);
+static void printArcSets(const char *declaration, const arcSet *sets,
+        int n);
+static void printVertexLists(const char *name, const uint64_t *masks,
+        int n);
+static void printArcLists(const char *name, const arcSet *sets, int n);
+static void printAdjacency(const char *name, const int *starts,
+        const int *list, int n);
+static void printPaths(const char *declaration, char paths[][PATH_LIMIT],
+        int n);
+
+int main(void) {
+    buildTopology();
+    buildPathDecoder();
+    buildShortestPaths();
+
+    printf("/*\n"
+           " * boardTopologyTables.h\n"
+           " * Generated by tools/genTopology.c, do not edit.\n"
+           " *\n"
+           " * Only boardTopology.c includes this file. Everything in it\n"
+           " * is declared in boardTopology.h.\n"
+           " *\n"
+           " */\n\n");
+
+    printGrid("const int vertexIds[MAP_VERTEX_HEIGHT][MAP_VERTEX_WIDTH]",
+            &vertexIds[0][0], MAP_VERTEX_HEIGHT, MAP_VERTEX_WIDTH);
+    printGrid("const int arcIds[MAP_ARC_HEIGHT][MAP_ARC_WIDTH]",
+            &arcIds[0][0], MAP_ARC_HEIGHT, MAP_ARC_WIDTH);
+    printCoords("const coord vertexCoords[NUM_VERTICES]", vertexCoords,
+            NUM_VERTICES);
+    printCoords("const coord arcCoords[NUM_ARCS]", arcCoords, NUM_ARCS);
+    printGrid("const int regionIds[MAP_REGION_HEIGHT][MAP_REGION_WIDTH]",
+            &regionIds[0][0], MAP_REGION_HEIGHT, MAP_REGION_WIDTH);
+
+    printMasks("const uint64_t vertexNeighbours[NUM_VERTICES]",
+            vertexNeighbours, NUM_VERTICES);
+    printArcSets("const arcSet vertexArcs[NUM_VERTICES]", vertexArcs,
+            NUM_VERTICES);
+    printArcSets("const arcSet arcNeighbours[NUM_ARCS]", arcNeighbours,
+            NUM_ARCS);
+    printMasks("const uint64_t arcEnds[NUM_ARCS]", arcEnds, NUM_ARCS);
+
+    printVertexLists("vertexNeighbour", vertexNeighbours, NUM_VERTICES);
+    printArcLists("vertexArc", vertexArcs, NUM_VERTICES);
+    printArcLists("arcNeighbour", arcNeighbours, NUM_ARCS);
+    printVertexLists("arcEnd", arcEnds, NUM_ARCS);
+
+    // vertex to region and the other way around
+    int starts[NUM_VERTICES + 1];
+    int list[NUM_VERTICES * MAX_VERTEX_REGIONS];
+    int used = 0;
+    int vertex = 0;
+    while (vertex < NUM_VERTICES) {
+        starts[vertex] = used;
+        int i = 0;
+        while (i < MAX_VERTEX_REGIONS &&
+                vertexRegions[vertex][i] != INVALID_ID) {
+            list[used] = vertexRegions[vertex][i];
+            used++;
+            i++;
+        }
+        vertex++;
+    }
+    starts[NUM_VERTICES] = used;
+    printAdjacency("vertexRegion", starts, list, NUM_VERTICES);
+
+    int regionStarts[NUM_REGIONS + 1];
+    used = 0;
+    int region = 0;
+    while (region < NUM_REGIONS) {
+        regionStarts[region] = used;
+        vertex = 0;
+        while (vertex < NUM_VERTICES) {
+            int i = 0;
+            while (i < MAX_VERTEX_REGIONS) {
+                if (vertexRegions[vertex][i] == region) {
+                    list[used] = vertex;
+                    used++;
+                }
+                i++;
+            }
+            vertex++;
+        }
+        region++;
+    }
+    regionStarts[NUM_REGIONS] = used;
+    printAdjacency("regionVertex", regionStarts, list, NUM_REGIONS);
+
+    printTable("const int vertexRetrainDiscipline[NUM_VERTICES]",
+            vertexRetrainDiscipline, NUM_VERTICES);
+
+    printTable("const signed char stepClasses[256]", stepClasses, 256);
+    printGrid("const short pathTransitions[NUM_PATH_STATES]"
+            "[NUM_STEP_CLASSES]", &pathTransitions[0][0],
+            NUM_PATH_STATES, NUM_STEP_CLASSES);
+    printTable("const short pathStateVertex[NUM_PATH_STATES]",
+            pathStateVertex, NUM_PATH_STATES);
+    printTable("const short pathStateArc[NUM_PATH_STATES]", pathStateArc,
+            NUM_PATH_STATES);
+
+    printPaths("const char *const vertexPaths[NUM_VERTICES]", vertexPaths,
+            NUM_VERTICES);
+    printPaths("const char *const arcPaths[NUM_ARCS]", arcPaths, NUM_ARCS);
+    return 0;
+}
+
+// hands out the dense vertex, ARC and region IDs and works out what
+// touches what
+static void buildTopology(void) {
+    int vertexId = 0;
+    int y = 0;
+    while (y < MAP_VERTEX_HEIGHT) {
+        int x = 0;
+        while (x < MAP_VERTEX_WIDTH) {
+            vertexIds[y][x] = INVALID_ID;
+            if (isValidVertex(x, y)) {
+                vertexIds[y][x] = vertexId;
+                vertexCoords[vertexId].x = x;
+                vertexCoords[vertexId].y = y;
+                vertexId++;
+            }
+            x++;
+        }
+        y++;
+    }
+    assert(vertexId == NUM_VERTICES);
+
+    int arcId = 0;
+    y = 0;
+    while (y < MAP_ARC_HEIGHT) {
+        int x = 0;
+        while (x < MAP_ARC_WIDTH) {
+            arcIds[y][x] = INVALID_ID;
+            if (isValidARC(x, y)) {
+                arcIds[y][x] = arcId;
+                arcCoords[arcId].x = x;
+                arcCoords[arcId].y = y;
+                arcId++;
+            }
+            x++;
+        }
+        y++;
+    }
+    assert(arcId == NUM_ARCS);
+
+    // regions are numbered column by column, top to bottom, like
+    // the arrays given to newGame
+    int regionID = 0;
+    int x = 0;
+    while (x < MAP_REGION_WIDTH) {
+        y = 0;
+        while (y < MAP_REGION_HEIGHT) {
+            regionIds[y][x] = INVALID_ID;
+            if (isValidRegion(x, y)) {
+                regionIds[y][x] = regionID;
+                regionID++;
+            }
+            y++;
+        }
+        x++;
+    }
+    assert(regionID == NUM_REGIONS);
+
+    // region (x, y) touches the vertices x..x+1, y..y+2
+    int vertex = 0;
+    while (vertex < NUM_VERTICES) {
+        int found = 0;
+        int regionY = vertexCoords[vertex].y - 2;
+        while (regionY <= vertexCoords[vertex].y) {
+            int regionX = vertexCoords[vertex].x - 1;
+            while (regionX <= vertexCoords[vertex].x) {
+                if (isValidRegion(regionX, regionY)) {
+                    assert(found < MAX_VERTEX_REGIONS);
+                    vertexRegions[vertex][found] =
+                            regionIds[regionY][regionX];
+                    found++;
+                }
+                regionX++;
+            }
+            regionY++;
+        }
+        while (found < MAX_VERTEX_REGIONS) {
+            vertexRegions[vertex][found] = INVALID_ID;
+            found++;
+        }
+        vertex++;
+    }
+
+    // an ARC joins the two vertices either side of it in the
+    // doubled grid, which gives every other adjacency
+    memset(vertexNeighbours, 0, sizeof(vertexNeighbours));
+    memset(vertexArcs, 0, sizeof(vertexArcs));
+    int arc = 0;
+    while (arc < NUM_ARCS) {
+        coord c = arcCoords[arc];
+        int a;
+        int b;
+        if (c.y % 2 == 1) {
+            a = vertexIds[(c.y - 1) / 2][c.x / 2];
+            b = vertexIds[(c.y + 1) / 2][c.x / 2];
+        } else {
+            a = vertexIds[c.y / 2][(c.x - 1) / 2];
+            b = vertexIds[c.y / 2][(c.x + 1) / 2];
+        }
+        assert(a != INVALID_ID && b != INVALID_ID);
+        arcEnds[arc] = ((uint64_t) 1 << a) | ((uint64_t) 1 << b);
+        vertexNeighbours[a] |= (uint64_t) 1 << b;
+        vertexNeighbours[b] |= (uint64_t) 1 << a;
+        arcSetAdd(&vertexArcs[a], arc);
+        arcSetAdd(&vertexArcs[b], arc);
+        arc++;
+    }
+    arc = 0;
+    while (arc < NUM_ARCS) {
+        arcNeighbours[arc].lo = 0;
+        arcNeighbours[arc].hi = 0;
+        int v = 0;
+        while (v < NUM_VERTICES) {
+            if ((arcEnds[arc] >> v) & 1) {
+                arcNeighbours[arc].lo |= vertexArcs[v].lo;
+                arcNeighbours[arc].hi |= vertexArcs[v].hi;
+            }
+            v++;
+        }
+        // an ARC is not its own neighbour
+        arcSetRemove(&arcNeighbours[arc], arc);
+        arc++;
+    }
+
+    buildRetrainCentres();
+}
+
+// the retraining centres sit on pairs of coastal vertices:
+// 2,1 1,1 - MTV
+// 3,1 4,1 - MMONEY
+// 1,8 1,9 - BPS
+// 4,8 4,9 - MJ
+// 5,5 5,6 - BQN
+static void buildRetrainCentres(void) {
+    static const int centres[][3] = {
+        {1, 1, STUDENT_MTV}, {2, 1, STUDENT_MTV},
+        {3, 1, STUDENT_MMONEY}, {4, 1, STUDENT_MMONEY},
+        {1, 8, STUDENT_BPS}, {1, 9, STUDENT_BPS},
+        {4, 8, STUDENT_MJ}, {4, 9, STUDENT_MJ},
+        {5, 5, STUDENT_BQN}, {5, 6, STUDENT_BQN}
+    };
+    int vertex = 0;
+    while (vertex < NUM_VERTICES) {
+        vertexRetrainDiscipline[vertex] = INVALID_ID;
+        vertex++;
+    }
+    int i = 0;
+    while (i < (int) (sizeof(centres) / sizeof(centres[0]))) {
+        vertex = vertexIds[centres[i][1]][centres[i][0]];
+        assert(vertex != INVALID_ID);
+        vertexRetrainDiscipline[vertex] = centres[i][2];
+        i++;
+    }
+}
+
+// walks a single step of a path from cur, having arrived from prev,
+// and returns the vertex the step leads to. the result may be off
+// the island. only used to build the decoder table.
+static coord stepFrom(coord cur, coord prev, int stepClass) {
+    coord next = cur;
+    if (stepClass == STEP_B) {
+        next = prev;
+    } else if (cur.y == prev.y) {
+        // moving along the x axis, so turning changes the y value
+        if ((cur.x < prev.x) == (stepClass == STEP_L)) {
+            next.y += 1;
+        } else {
+            next.y -= 1;
+        }
+    } else if (cur.x == prev.x) {
+        // moving along the y axis
+        if (stepClass == STEP_L) {
+            if (cur.y < prev.y) {
+                // facing towards the x axis
+                if (cur.y % 2 == cur.x % 2) {
+                    next.y -= 1;
+                } else {
+                    next.x -= 1;
+                }
+            } else {
+                if ((cur.y % 2 != cur.x % 2) ||
+                        (cur.x == 5 && cur.y % 2 == 0)) {
+                    next.y += 1;
+                } else {
+                    next.x += 1;
+                }
+            }
+        } else {
+            if (cur.y < prev.y) {
+                if (cur.x % 2 != cur.y % 2) {
+                    next.y -= 1;
+                } else {
+                    next.x += 1;
+                }
+            } else {
+                if (cur.x % 2 == cur.y % 2) {
+                    next.y += 1;
+                } else {
+                    next.x -= 1;
+                }
+            }
+        }
+    } else {
+        // this only happens on the first step, where we are at the top
+        // campus of A facing inwards
+        if (stepClass == STEP_L) {
+            next.x = 3;
+            next.y = 0;
+        } else {
+            next.x = 2;
+            next.y = 1;
+        }
+    }
+    return next;
+}
+
+// builds the path decoder by walking every (vertex, heading) state
+// one step in each direction
+static void buildPathDecoder(void) {
+    int c = 0;
+    while (c < 256) {
+        stepClasses[c] = STEP_INVALID;
+        c++;
+    }
+    stepClasses['L'] = STEP_L;
+    stepClasses['R'] = STEP_R;
+    stepClasses['B'] = STEP_B;
+    stepClasses[0] = STEP_END;
+
+    int state = 0;
+    while (state < NUM_PATH_STATES) {
+        coord cur;
+        coord prev;
+        if (state == PATH_STATE_START) {
+            // at the top campus of A, facing inwards
+            cur = vertexCoords[0];
+            prev.x = cur.x - 1;
+            prev.y = cur.y - 1;
+            pathStateVertex[state] = 0;
+            pathStateArc[state] = INVALID_ID;
+        } else if (state == PATH_STATE_DEAD) {
+            pathStateVertex[state] = INVALID_ID;
+            pathStateArc[state] = INVALID_ID;
+        } else {
+            int heading = state % NUM_HEADINGS;
+            cur = vertexCoords[state / NUM_HEADINGS];
+            prev.x = cur.x - headingDx[heading];
+            prev.y = cur.y - headingDy[heading];
+            pathStateVertex[state] = state / NUM_HEADINGS;
+            // the ARC coordinates are the sum of the two vertex ones
+            pathStateArc[state] = INVALID_ID;
+            if (prev.x >= 0 && prev.y >= 0 &&
+                    cur.x + prev.x < MAP_ARC_WIDTH &&
+                    cur.y + prev.y < MAP_ARC_HEIGHT) {
+                pathStateArc[state] =
+                        arcIds[cur.y + prev.y][cur.x + prev.x];
+            }
+        }
+
+        int stepClass = STEP_L;
+        while (stepClass < NUM_STEP_CLASSES) {
+            int next = PATH_STATE_DEAD;
+            if (stepClass == STEP_END) {
+                next = state;
+            } else if (state != PATH_STATE_DEAD &&
+                    stepClass != STEP_INVALID &&
+                    !(state == PATH_STATE_START && stepClass == STEP_B)) {
+                coord to = stepFrom(cur, prev, stepClass);
+                if (isValidVertex(to.x, to.y)) {
+                    int heading = 0;
+                    while (to.x - cur.x != headingDx[heading] ||
+                            to.y - cur.y != headingDy[heading]) {
+                        heading++;
+                    }
+                    next = vertexIds[to.y][to.x] * NUM_HEADINGS + heading;
+                }
+            }
+            pathTransitions[state][stepClass] = next;
+            stepClass++;
+        }
+        state++;
+    }
+}
+
+// a breadth first search over the path decoder from the start state,
+// so the first path found to each vertex and ARC is a shortest one
+static void buildShortestPaths(void) {
+    static char statePaths[NUM_PATH_STATES][PATH_LIMIT];
+    int seen[NUM_PATH_STATES] = {0};
+    int queue[NUM_PATH_STATES];
+    const char steps[] = {'L', 'R', 'B'};
+    memset(vertexPaths, 0, sizeof(vertexPaths));
+    memset(arcPaths, 0, sizeof(arcPaths));
+    int vertexFound[NUM_VERTICES] = {0};
+    int arcFound[NUM_ARCS] = {0};
+
+    int head = 0;
+    int tail = 0;
+    queue[tail] = PATH_STATE_START;
+    tail++;
+    seen[PATH_STATE_START] = TRUE;
+    statePaths[PATH_STATE_START][0] = 0;
+    while (head < tail) {
+        int state = queue[head];
+        head++;
+        int vertex = pathStateVertex[state];
+        int arc = pathStateArc[state];
+        if (vertex != INVALID_ID && !vertexFound[vertex]) {
+            strcpy(vertexPaths[vertex], statePaths[state]);
+            vertexFound[vertex] = TRUE;
+        }
+        if (arc != INVALID_ID && !arcFound[arc]) {
+            strcpy(arcPaths[arc], statePaths[state]);
+            arcFound[arc] = TRUE;
+        }
+
+        int step = 0;
+        while (step < 3) {
+            int next = pathTransitions[state][stepClasses[
+                    (unsigned char) steps[step]]];
+            if (next != PATH_STATE_DEAD && !seen[next]) {
+                int length = strlen(statePaths[state]);
+                assert(length + 1 < PATH_LIMIT);
+                memcpy(statePaths[next], statePaths[state], length);
+                statePaths[next][length] = steps[step];
+                statePaths[next][length + 1] = 0;
+                seen[next] = TRUE;
+                queue[tail] = next;
+                tail++;
+            }
+            step++;
+        }
+    }
+
+    int i = 0;
+    while (i < NUM_VERTICES) {
+        assert(vertexFound[i]);
+        i++;
+    }
+    i = 0;
+    while (i < NUM_ARCS) {
+        assert(arcFound[i]);
+        i++;
+    }
+}
+
+// prints values separated by commas, wrapping long lines
+static void printValues(const int *values, int n, const char *indent) {
+    int i = 0;
+    while (i < n) {
+        if (i % VALUES_PER_LINE == 0) {
+            printf("%s", indent);
+        }
+        printf("%d", values[i]);
+        if (i + 1 < n) {
+            printf(",");
+            if ((i + 1) % VALUES_PER_LINE == 0) {
+                printf("\n");
+            } else {
+                printf(" ");
+            }
+        }
+        i++;
+    }
+}
+
+static void printTable(const char *declaration, const int *values,
+        int n) {
+    printf("%s = {\n", declaration);
+    printValues(values, n, "    ");
+    printf("\n};\n\n");
+}
+
+static void printGrid(const char *declaration, const int *values,
+        int rows, int columns) {
+    printf("%s = {\n", declaration);
+    int row = 0;
+    while (row < rows) {
+        printf("    {");
+        printValues(&values[row * columns], columns, "");
+        printf("}%s\n", row + 1 < rows ? "," : "");
+        row++;
+    }
+    printf("};\n\n");
+}
+
+static void printCoords(const char *declaration, const coord *coords,
+        int n) {
+    printf("%s = {\n", declaration);
+    int i = 0;
+    while (i < n) {
+        if (i % 6 == 0) {
+            printf("    ");
+        }
+        printf("{%d, %d}", coords[i].x, coords[i].y);
+        if (i + 1 < n) {
+            printf(",%s", (i + 1) % 6 == 0 ? "\n" : " ");
+        }
+        i++;
+    }
+    printf("\n};\n\n");
+}
+
+static void printMasks(const char *declaration, const uint64_t *masks,
+        int n) {
+    printf("%s = {\n", declaration);
+    int i = 0;
+    while (i < n) {
+        printf("    0x%016llxULL%s\n", (unsigned long long) masks[i],
+                i + 1 < n ? "," : "");
+        i++;
+    }
+    printf("};\n\n");
+}
+
+static void printArcSets(const char *declaration, const arcSet *sets,
+        int n) {
+    printf("%s = {\n", declaration);
+    int i = 0;
+    while (i < n) {
+        printf("    {0x%016llxULL, 0x%016llxULL}%s\n",
+                (unsigned long long) sets[i].lo,
+                (unsigned long long) sets[i].hi, i + 1 < n ? "," : "");
+        i++;
+    }
+    printf("};\n\n");
+}
+
+// the IDs in each mask, lowest first, as an adjacency list
+static void printVertexLists(const char *name, const uint64_t *masks,
+        int n) {
+    int starts[NUM_ARCS + 1];
+    int list[NUM_ARCS * NUM_VERTICES];
+    int used = 0;
+    int i = 0;
+    while (i < n) {
+        starts[i] = used;
+        int vertex = 0;
+        while (vertex < NUM_VERTICES) {
+            if ((masks[i] >> vertex) & 1) {
+                list[used] = vertex;
+                used++;
+            }
+            vertex++;
+        }
+        i++;
+    }
+    starts[n] = used;
+    printAdjacency(name, starts, list, n);
+}
+
+static void printArcLists(const char *name, const arcSet *sets, int n) {
+    int starts[NUM_ARCS + 1];
+    int list[NUM_ARCS * NUM_ARCS];
+    int used = 0;
+    int i = 0;
+    while (i < n) {
+        starts[i] = used;
+        int arc = 0;
+        while (arc < NUM_ARCS) {
+            if (arcSetHas(sets[i], arc)) {
+                list[used] = arc;
+                used++;
+            }
+            arc++;
+        }
+        i++;
+    }
+    starts[n] = used;
+    printAdjacency(name, starts, list, n);
+}
+
+// an adjacency list in compressed sparse row form: the entries for
+// item i are list[starts[i]] up to but not including list[starts[i+1]]
+static void printAdjacency(const char *name, const int *starts,
+        const int *list, int n) {
+    char declaration[128];
+    snprintf(declaration, sizeof(declaration),
+            "const int %sStart[%d]", name, n + 1);
+    printTable(declaration, starts, n + 1);
+    snprintf(declaration, sizeof(declaration),
+            "const int %sList[%d]", name, starts[n]);
+    printTable(declaration, list, starts[n]);
+}
+
+static void printPaths(const char *declaration, char paths[][PATH_LIMIT],
+        int n) {
+    printf("%s = {\n", declaration);
+    int i = 0;
+    while (i < n) {
+        printf("    \"%s\"%s\n", paths[i], i + 1 < n ? "," : "");
+        i++;
+    }
+    printf("};\n\n");
+}
+
+static int isValidRegion(int x, int y) {
+    // needs documentation
+    int valid = TRUE;
+    if (y > 8 || y < 0 || x < 0 || x > 4) {
+        valid = FALSE;
+    } else if (y == 0 && x != 2) {
+        valid = FALSE;
+    } else if ((y == 1 || y == 8) && (x == 0 || x == 4)) {
+        valid = FALSE;
+    } else if (x % 2 != y % 2) {
+        valid = FALSE;
+    }
+    return valid;
+}
+
+static int isValidVertex(int x, int y) {
+    int valid = TRUE;
+    if (x > 5 || x < 0 || y < 0 || y > 10) {
+        valid = FALSE;
+    } else if ((y == 0 || y == 10) && !(x == 2 || x == 3)) {
+        valid = FALSE;
+    } else if ((y == 1 || y == 9) && (x == 0 || x == 5)) {
+        valid = FALSE;
+    }
+    return valid;
+}
+
+static int isValidARC(int x, int y) {
+    int valid = TRUE;
+    // (odd, odd) and (even, even) arcs don't exist
+    if (y % 2 == x % 2) {
+        valid = FALSE;
+    } else if (y % 2 == 0 && x % 2 == 1) {
+        // if y divisible by four
+        // x 3 and 7 will be invalid
+        // else, x 1 5 and 9 will be invalid
+        if (y % 4 == 0) {
+            if (x == 3 || x == 7) {
+                valid = FALSE;
+            }
+        } else {
+            if (x == 1 || x == 5 || x == 9) {
+                valid = FALSE;
+            }
+        }
+    }
+
+    if ((x <= 1 || x >= 9) && (y < 4 || y > 16)) { // outside board
+        valid = FALSE;
+    } else if ((x < 4 || x > 6) && (y > 18 || y < 2)) {
+        valid = FALSE;
+    }
+
+    if (x > 10 || x < 0 || y < 0 || y > 20) {
+        valid = FALSE;
+    }
+    return valid;
+}
+
+// vim: sts=4 et cc=72
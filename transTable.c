@@ -0,0 +1,200 @@
+/*
+ * transTable.c
+ * A shared transposition table for searching Knowledge Island
+ *
+ * Copyright 2015 Simon Shields, Harrison Shoebridge, Julian Tu and James Ye
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <stdint.h>
+#include "Game.h"
+#include "transTable.h"
+
+#define BUCKET_SIZE 2
+#define CACHE_LINE 64
+
+// an entry's data word, from the bottom up: the three values, the
+// weight, the bound plus one (so a used entry is never all zeroes)
+// and the age of the search that stored it
+#define VALUE_BITS 14
+#define VALUE_MAX ((1 << VALUE_BITS) - 1)
+#define WEIGHT_SHIFT (VALUE_BITS * NUM_UNIS)
+#define WEIGHT_BITS 14
+#define BOUND_SHIFT (WEIGHT_SHIFT + WEIGHT_BITS)
+#define BOUND_BITS 2
+#define AGE_SHIFT (BOUND_SHIFT + BOUND_BITS)
+#define AGE_BITS 6
+#define AGE_MASK ((1 << AGE_BITS) - 1)
+
+#define FIELD(data, shift, bits) \
+        ((int) (((data) >> (shift)) & ((1 << (bits)) - 1)))
+
+typedef struct _slot {
+    uint64_t check;     // the key xored with data
+    uint64_t data;
+} slot;
+
+typedef struct _transTable {
+    slot *slots;
+    size_t numBuckets;
+    int age;
+} transTable;
+
+static uint64_t packEntry(const ttEntry *entry, int age);
+static void unpackEntry(uint64_t data, ttEntry *entry);
+static int replaceScore(uint64_t data, int age);
+static void loadSlot(slot *s, uint64_t *check, uint64_t *data);
+
+TransTable newTransTable(size_t memoryBytes) {
+    TransTable t = malloc(sizeof(transTable));
+    assert(t != NULL);
+    size_t bucketBytes = sizeof(slot) * BUCKET_SIZE;
+    t->numBuckets = 1;
+    while (t->numBuckets * 2 * bucketBytes <= memoryBytes) {
+        t->numBuckets *= 2;
+    }
+    void *slots = NULL;
+    int failed = posix_memalign(&slots, CACHE_LINE,
+                                t->numBuckets * bucketBytes);
+    assert(!failed);
+    t->slots = slots;
+    t->age = 0;
+    clearTransTable(t);
+    return t;
+}
+
+void disposeTransTable(TransTable t) {
+    free(t->slots);
+    free(t);
+}
+
+size_t getTransTableEntries(TransTable t) {
+    return t->numBuckets * BUCKET_SIZE;
+}
+
+void clearTransTable(TransTable t) {
+    memset(t->slots, 0, sizeof(slot) * BUCKET_SIZE * t->numBuckets);
+}
+
+void ageTransTable(TransTable t) {
+    t->age = (t->age + 1) & AGE_MASK;
+}
+
+int probeTransTable(TransTable t, uint64_t key, ttEntry *entry) {
+    int found = FALSE;
+    slot *bucket = &t->slots[(key & (t->numBuckets - 1)) * BUCKET_SIZE];
+    int i = 0;
+    while (!found && i < BUCKET_SIZE) {
+        uint64_t check;
+        uint64_t data;
+        loadSlot(&bucket[i], &check, &data);
+        if (data != 0 && (check ^ data) == key) {
+            unpackEntry(data, entry);
+            found = TRUE;
+        }
+        i++;
+    }
+    return found;
+}
+
+void storeTransTable(TransTable t, uint64_t key, const ttEntry *entry) {
+    slot *bucket = &t->slots[(key & (t->numBuckets - 1)) * BUCKET_SIZE];
+    int victim = 0;
+    int victimScore = -1;
+    int i = 0;
+    while (i < BUCKET_SIZE && victimScore != INT32_MAX) {
+        uint64_t check;
+        uint64_t data;
+        loadSlot(&bucket[i], &check, &data);
+        int score;
+        if (data != 0 && (check ^ data) == key) {
+            score = INT32_MAX;
+        } else {
+            score = replaceScore(data, t->age);
+        }
+        if (score > victimScore) {
+            victim = i;
+            victimScore = score;
+        }
+        i++;
+    }
+
+    // two threads picking the same slot at once can leave it with
+    // one's check and the other's data, which then matches neither
+    uint64_t data = packEntry(entry, t->age);
+    __atomic_store_n(&bucket[victim].data, data, __ATOMIC_RELAXED);
+    __atomic_store_n(&bucket[victim].check, key ^ data,
+                     __ATOMIC_RELAXED);
+}
+
+static uint64_t packEntry(const ttEntry *entry, int age) {
+    uint64_t data = 0;
+    int i = 0;
+    while (i < NUM_UNIS) {
+        float value = entry->value[i];
+        if (value < 0) {
+            value = 0;
+        } else if (value > 1) {
+            value = 1;
+        }
+        uint64_t scaled = (uint64_t) (value * VALUE_MAX + 0.5f);
+        data |= scaled << (i * VALUE_BITS);
+        i++;
+    }
+    int weight = entry->weight;
+    if (weight < 0) {
+        weight = 0;
+    } else if (weight > TT_MAX_WEIGHT) {
+        weight = TT_MAX_WEIGHT;
+    }
+    data |= (uint64_t) weight << WEIGHT_SHIFT;
+    data |= (uint64_t) (entry->bound + 1) << BOUND_SHIFT;
+    data |= (uint64_t) age << AGE_SHIFT;
+    return data;
+}
+
+static void unpackEntry(uint64_t data, ttEntry *entry) {
+    int i = 0;
+    while (i < NUM_UNIS) {
+        entry->value[i] = (float) FIELD(data, i * VALUE_BITS,
+                                        VALUE_BITS) / VALUE_MAX;
+        i++;
+    }
+    entry->weight = FIELD(data, WEIGHT_SHIFT, WEIGHT_BITS);
+    entry->bound = FIELD(data, BOUND_SHIFT, BOUND_BITS) - 1;
+}
+
+// higher is replaced first: empty slots, then entries by how many
+// searches ago they were stored, then by how little weight they have
+static int replaceScore(uint64_t data, int age) {
+    int score = INT32_MAX - 1;
+    if (data != 0) {
+        int searchesAgo = (age - FIELD(data, AGE_SHIFT, AGE_BITS)) &
+                AGE_MASK;
+        score = searchesAgo * (TT_MAX_WEIGHT + 1) +
+                TT_MAX_WEIGHT - FIELD(data, WEIGHT_SHIFT, WEIGHT_BITS);
+    }
+    return score;
+}
+
+static void loadSlot(slot *s, uint64_t *check, uint64_t *data) {
+    *check = __atomic_load_n(&s->check, __ATOMIC_RELAXED);
+    *data = __atomic_load_n(&s->data, __ATOMIC_RELAXED);
+}
+
+// vim: sts=4 et cc=72
@@ -0,0 +1,76 @@
+/*
+ * transTable.h
+ * A shared transposition table for searching Knowledge Island
+ *
+ * Copyright 2015 Simon Shields, Harrison Shoebridge, Julian Tu and James Ye
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * The table maps a position's getCanonicalHash() to what a search
+ * found out about it. It has a power of two number of 16 byte entries
+ * in buckets of two and never takes a lock: each entry is written as
+ * two words with the key xored into one of them, so a reader that
+ * sees half of someone else's write just misses. Any number of
+ * threads can probe and store at once. Include Game.h before this
+ * file.
+ *
+ */
+
+#ifndef TRANS_TABLE_H
+#define TRANS_TABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// how value[0] relates to the true value of the position
+#define TT_EXACT 0
+#define TT_LOWER 1
+#define TT_UPPER 2
+
+// the most a weight can be, larger weights are stored as this
+#define TT_MAX_WEIGHT 16383
+
+typedef struct _transTable *TransTable;
+
+// what is known about a position. values are relative to the player
+// to move: value[0] is theirs, value[1] belongs to the next player
+// and value[2] to the one after that. each is between 0 and 1 and is
+// stored to within about 0.0001.
+typedef struct _ttEntry {
+    float value[NUM_UNIS];
+    int weight;     // visits for MCTS, search depth for expectimax
+    int bound;      // TT_EXACT, TT_LOWER or TT_UPPER
+} ttEntry;
+
+// a table that fits in memoryBytes, rounded down to a power of two
+// number of entries. it always has at least one bucket
+TransTable newTransTable(size_t memoryBytes);
+void disposeTransTable(TransTable t);
+size_t getTransTableEntries(TransTable t);
+
+// empties the table
+void clearTransTable(TransTable t);
+
+// starts a new search. entries stored before this are the first to
+// be replaced from now on, but can still be found
+void ageTransTable(TransTable t);
+
+// TRUE and fills in entry if key is in the table
+int probeTransTable(TransTable t, uint64_t key, ttEntry *entry);
+
+// stores entry under key. an entry already there for key is always
+// overwritten, otherwise the entry in the bucket from the oldest
+// search, then with the lowest weight, makes way
+void storeTransTable(TransTable t, uint64_t key, const ttEntry *entry);
+
+#endif
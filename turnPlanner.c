@@ -0,0 +1,248 @@
+/*
+ * turnPlanner.c
+ * Plans a whole turn of Knowledge Island at once
+ *
+ * Copyright 2015 Simon Shields, Harrison Shoebridge, Julian Tu and James Ye
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <stdint.h>
+#include "Game.h"
+#include "GameExt.h"
+#include "boardAnalysis.h"
+#include "turnPlanner.h"
+
+// the most states one plan looks at. turns with lots of students to
+// retrain can reach far more than this, and then the best plan among
+// the states seen is used
+#define MAX_PLAN_STATES 2048
+// room to remember which states have been seen, a power of two well
+// above MAX_PLAN_STATES so probes stay short
+#define SEEN_SIZE 4096
+
+// the end of a turn is scored by the player's KPIs, plus what their
+// campuses should produce, the best place they could build a campus
+// next and the students they have left
+#define PRODUCTION_WEIGHT 20.0f
+#define SITE_WEIGHT 10.0f
+#define STUDENT_WEIGHT 0.5f
+
+// the state hash that can't be predicted, after a spinoff
+#define UNKNOWN_HASH 0
+
+typedef struct _planSearch {
+    Game g;
+    int player;
+    BoardInfo board;
+    uint64_t seen[SEEN_SIZE];
+    int states;
+    move path[MAX_PLAN_LENGTH];
+    uint64_t pathHashes[MAX_PLAN_LENGTH + 1];
+    float bestScore;
+    int bestLength;
+    move best[MAX_PLAN_LENGTH];
+    uint64_t bestHashes[MAX_PLAN_LENGTH + 1];
+} planSearch;
+
+// the plan for the current turn, and how far through it we are.
+// hashes[i] is the state hash expected before plan[i] is made. each
+// thread has its own, so games on different threads don't mix plans
+static __thread move plan[MAX_PLAN_LENGTH];
+static __thread uint64_t planHashes[MAX_PLAN_LENGTH + 1];
+static __thread int planLength = 0;
+static __thread int planNext = 0;
+static __thread int planTurnNumber = -2;
+static __thread int lastStates = 0;
+
+static int makePlan(Game g, move planOut[], uint64_t hashesOut[]);
+static void explore(planSearch *ps, int length);
+static void tryMove(planSearch *ps, int length, move m);
+static void tryBest(planSearch *ps, int length, float score);
+static int markSeen(planSearch *ps, uint64_t hash);
+static float scoreTurn(planSearch *ps);
+
+#ifdef PLANNER_DECIDE_ACTION
+action decideAction(Game g) {
+    return decideActionPlanned(g);
+}
+#endif
+
+action decideActionPlanned(Game g) {
+    int turn = getTurnNumber(g);
+    if (turn != planTurnNumber || planNext > planLength ||
+            planHashes[planNext] != getStateHash(g)) {
+        planLength = makePlan(g, plan, planHashes);
+        planNext = 0;
+        planTurnNumber = turn;
+    }
+
+    action a = {PASS, "", 0, 0};
+    if (planNext < planLength) {
+        a = moveToAction(plan[planNext]);
+    }
+    planNext++;
+    return a;
+}
+
+int planTurn(Game g, move planOut[MAX_PLAN_LENGTH]) {
+    uint64_t hashes[MAX_PLAN_LENGTH + 1];
+    return makePlan(g, planOut, hashes);
+}
+
+int getLastPlanStates(void) {
+    return lastStates;
+}
+
+// finds the plan, and the state hash before each of its moves and
+// after the last one
+static int makePlan(Game g, move planOut[], uint64_t hashesOut[]) {
+    planSearch *ps = malloc(sizeof(planSearch));
+    assert(ps != NULL);
+    ps->g = cloneGame(g);
+    ps->player = getWhoseTurn(g);
+    ps->board = getBoardInfo(g);
+    memset(ps->seen, 0, sizeof(ps->seen));
+    ps->states = 0;
+    ps->bestLength = 0;
+    ps->pathHashes[0] = getStateHash(g);
+    ps->bestHashes[0] = ps->pathHashes[0];
+    ps->bestScore = scoreTurn(ps);
+    markSeen(ps, ps->pathHashes[0]);
+
+    explore(ps, 0);
+
+    int length = ps->bestLength;
+    memcpy(planOut, ps->best, sizeof(move) * length);
+    memcpy(hashesOut, ps->bestHashes, sizeof(uint64_t) * (length + 1));
+    lastStates = ps->states;
+    releaseBoardInfo(ps->board);
+    disposeGame(ps->g);
+    free(ps);
+    return length;
+}
+
+// depth first over every state reachable from here with the moves
+// in ps->path so far. a state reached before by another order of
+// the same moves is not searched again
+static void explore(planSearch *ps, int length) {
+    ps->states++;
+    tryBest(ps, length, scoreTurn(ps));
+    if (length < MAX_PLAN_LENGTH) {
+        move moves[MAX_LEGAL_MOVES];
+        int count = generateLegalActions(ps->g, moves, MAX_LEGAL_MOVES);
+        int i = 0;
+        while (i < count && ps->states < MAX_PLAN_STATES) {
+            tryMove(ps, length, moves[i]);
+            i++;
+        }
+    }
+}
+
+static void tryMove(planSearch *ps, int length, move m) {
+    ps->path[length] = m;
+    undoRecord undo;
+    if (MOVE_CODE(m) == START_SPINOFF) {
+        // the plan stops here, scored by how the spinoff goes on
+        // average: two thirds of the time a publication
+        makeActionWithUndo(ps->g, OBTAIN_PUBLICATION, INVALID_ID, 0, 0,
+                           &undo);
+        float score = scoreTurn(ps) * 2 / 3;
+        unmakeAction(ps->g, &undo);
+        makeActionWithUndo(ps->g, OBTAIN_IP_PATENT, INVALID_ID, 0, 0,
+                           &undo);
+        score += scoreTurn(ps) / 3;
+        unmakeAction(ps->g, &undo);
+        ps->states += 2;
+        ps->pathHashes[length + 1] = UNKNOWN_HASH;
+        tryBest(ps, length + 1, score);
+    } else {
+        makeMoveWithUndo(ps->g, m, &undo);
+        uint64_t hash = getStateHash(ps->g);
+        if (markSeen(ps, hash)) {
+            ps->pathHashes[length + 1] = hash;
+            explore(ps, length + 1);
+        }
+        unmakeAction(ps->g, &undo);
+    }
+}
+
+// keeps the first n moves of the path if they score better than the
+// best plan so far. ties go to the plan found first
+static void tryBest(planSearch *ps, int length, float score) {
+    if (score > ps->bestScore) {
+        ps->bestScore = score;
+        ps->bestLength = length;
+        memcpy(ps->best, ps->path, sizeof(move) * length);
+        memcpy(ps->bestHashes, ps->pathHashes,
+               sizeof(uint64_t) * (length + 1));
+    }
+}
+
+// TRUE if hash hasn't been seen before, and remembers it. once the
+// table is full nothing new is searched
+static int markSeen(planSearch *ps, uint64_t hash) {
+    if (hash == 0) {
+        hash = 1;
+    }
+    int isNew = FALSE;
+    int slot = hash & (SEEN_SIZE - 1);
+    int probes = 0;
+    while (!isNew && ps->seen[slot] != hash && probes < SEEN_SIZE) {
+        if (ps->seen[slot] == 0) {
+            ps->seen[slot] = hash;
+            isNew = TRUE;
+        }
+        slot = (slot + 1) & (SEEN_SIZE - 1);
+        probes++;
+    }
+    return isNew;
+}
+
+static float scoreTurn(planSearch *ps) {
+    Game g = ps->g;
+    int player = ps->player;
+    float score = getKPIpoints(g, player);
+    int discipline = STUDENT_BPS;
+    while (discipline <= STUDENT_MMONEY) {
+        score += STUDENT_WEIGHT * getStudents(g, player, discipline);
+        discipline++;
+    }
+    int vertex = 0;
+    while (vertex < NUM_VERTICES) {
+        int contents = getCampusAt(g, vertex);
+        float yield = getVertexYield(ps->board, vertex);
+        if (contents == player) {
+            score += PRODUCTION_WEIGHT * yield;
+        } else if (contents == player + NUM_UNIS) {
+            score += 2 * PRODUCTION_WEIGHT * yield;
+        }
+        vertex++;
+    }
+    float bestSite = 0;
+    uint64_t sites = getCampusFrontier(g, player);
+    while (sites != 0) {
+        float yield = getVertexYield(ps->board, __builtin_ctzll(sites));
+        if (yield > bestSite) {
+            bestSite = yield;
+        }
+        sites &= sites - 1;
+    }
+    return score + SITE_WEIGHT * bestSite;
+}
+
+// vim: sts=4 et cc=72
@@ -0,0 +1,50 @@
+/*
+ * turnPlanner.h
+ * Plans a whole turn of Knowledge Island at once
+ *
+ * Copyright 2015 Simon Shields, Harrison Shoebridge, Julian Tu and James Ye
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Until the player passes nothing but their own actions changes the
+ * game, so the best run of builds and retrains for a turn can be
+ * found in one go. planTurn() searches every state reachable this
+ * turn, skipping ones already reached another way, for the one that
+ * scores best. decideActionPlanned() plans on the first call of a
+ * turn and hands out the rest of the plan on later calls, checking
+ * the game is where the plan expects. Compile turnPlanner.c with
+ * -DPLANNER_DECIDE_ACTION and leave out mechanicalTurk.c to use it
+ * as decideAction(). Include Game.h before this file.
+ *
+ */
+
+#ifndef TURN_PLANNER_H
+#define TURN_PLANNER_H
+
+// the longest plan planTurn() makes
+#define MAX_PLAN_LENGTH 32
+
+// writes the best actions for the current player to take this turn
+// into plan, not counting the PASS at the end, and returns how many
+// there are. a START_SPINOFF can only come last, since what happens
+// after it is up to chance
+int planTurn(Game g, move plan[MAX_PLAN_LENGTH]);
+
+// the next action of the plan for this turn, making the plan first
+// if there isn't one or the game has gone somewhere it didn't expect
+action decideActionPlanned(Game g);
+
+// how many states the last planTurn() on this thread looked at
+int getLastPlanStates(void);
+
+#endif